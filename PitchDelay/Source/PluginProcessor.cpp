@@ -8,6 +8,37 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#if SPLUTTER_PROFILE
+ #include <sstream>
+#endif
+
+// Names of the note values for the tempo synced rate and delay.
+static const char* const note_value_names[NUM_NOTE_VALUES] = {
+    "Free", "1/16", "1/8 T", "1/16 .", "1/8", "1/4 T", "1/8 .", "1/4", "1/2 T", "1/4 .", "1/2", "1 bar", "2 bars"
+};
+// A factory program sets the first NUM_PARAMETERS params (in the same order),
+// the engine, its overlap and the trajectory shape. Everything else goes back
+// to its default.
+struct FactoryProgram {
+    const char* name;
+    float values[NUM_PARAMETERS];
+    int engine;
+    int overlap;
+    int shape;
+};
+
+static const FactoryProgram factory_programs[NUM_PROGRAMS] = {
+    // name                    feedback dry/wet pitch  rate    min delay lo cut  hi cut
+    { "Init",                  { 0.0f,  0.5f,   0.0f,  1.0f,   1.0f,     10.0f,  20000.0f }, engine_sawtooth, 2, shape_sawtooth },
+    { "Diminished Bubbles",    { 0.6f,  0.5f,   3.0f,  0.12f,  0.0f,     10.0f,  20000.0f }, engine_sawtooth, 2, shape_sawtooth },
+    { "Laser Gun",             { 0.8f,  0.6f,  24.0f,  0.05f,  0.0f,    200.0f,  20000.0f }, engine_sawtooth, 2, shape_sawtooth },
+    { "Ominous Growl",         { 0.7f,  0.6f, -12.0f,  0.08f,  0.05f,    10.0f,   3000.0f }, engine_overlap,  3, shape_sawtooth },
+    { "Sparkling Overtones",   { 0.5f,  0.4f,  12.0f,  0.3f,   0.1f,    400.0f,  20000.0f }, engine_spectral, 2, shape_sawtooth },
+    { "Spiral Down",           { 0.85f, 0.5f,  -5.0f,  0.5f,   0.25f,    10.0f,   8000.0f }, engine_overlap,  4, shape_sawtooth },
+    { "Slapback Fifth",        { 0.2f,  0.4f,   7.0f,  0.2f,   0.12f,    10.0f,  20000.0f }, engine_sawtooth, 2, shape_sawtooth },
+    { "Frozen Octave",         { 0.9f,  0.5f, -12.0f,  1.0f,   0.0f,     80.0f,  12000.0f }, engine_spectral, 2, shape_sawtooth },
+    { "Wandering Tape",        { 0.3f,  0.5f,   0.3f,  0.6f,   0.02f,    60.0f,  12000.0f }, engine_trajectory, 2, shape_random_walk },
+};
 
 //==============================================================================
 PitchDelayAudioProcessor::PitchDelayAudioProcessor()
@@ -46,14 +77,29 @@ PitchDelayAudioProcessor::PitchDelayAudioProcessor()
     params[5] = lo_cut;
     params[6] = hi_cut;
     
-    for (int i = 0; i < NUM_PARAMETERS; ++i) {
+    for (int band = 0; band < NUM_EQ_BANDS; ++band) {
+        eq_freq[band] = new ParameterVals;
+        eq_gain[band] = new ParameterVals;
+        eq_q[band] = new ParameterVals;
+        
+        std::string number = std::to_string(band + 1);
+        eq_freq[band]->name = "eqfreq" + number;
+        eq_gain[band]->name = "eqgain" + number;
+        eq_q[band]->name = "eqq" + number;
+        
+        params[NUM_PARAMETERS + 3 * band] = eq_freq[band];
+        params[NUM_PARAMETERS + 3 * band + 1] = eq_gain[band];
+        params[NUM_PARAMETERS + 3 * band + 2] = eq_q[band];
+    }
+    
+    for (int i = 0; i < NUM_STORED_PARAMETERS; ++i) {
         params[i]->param_code = i;
     }
     
     auto feedback_range = juce::NormalisableRange<float> (0.0f, 0.95f);
     auto dry_wet_range = juce::NormalisableRange<float> (0.0f, 1.0f);
     auto pitch_shift_range = juce::NormalisableRange<float> (-max_pitch_shift, max_pitch_shift);
-    auto lfo_range = juce::NormalisableRange<float> (0.025f, max_lfo_rate);
+    auto lfo_range = juce::NormalisableRange<float> (min_lfo_rate, max_lfo_rate);
     auto min_delay_range = juce::NormalisableRange<float> (0.0, max_delay_slider_val);
     auto lo_filter_range = juce::NormalisableRange<float> (10.0, 2000.0);
     auto hi_filter_range = juce::NormalisableRange<float> (200.0, 20000.0);
@@ -66,17 +112,84 @@ PitchDelayAudioProcessor::PitchDelayAudioProcessor()
     lo_cut->u_param = new juce::AudioParameterFloat("Low cut", "lo", lo_filter_range, 10.0);
     hi_cut->u_param = new juce::AudioParameterFloat("High cut", "hi", hi_filter_range, 20000.0);
     
-    for (int i = 0; i < NUM_PARAMETERS; ++i) {
+    auto eq_freq_range = juce::NormalisableRange<float> (20.0, 20000.0);
+    auto eq_gain_range = juce::NormalisableRange<float> (-18.0, 18.0);
+    auto eq_q_range = juce::NormalisableRange<float> (0.1, 10.0);
+    
+    for (int band = 0; band < NUM_EQ_BANDS; ++band) {
+        std::string number = std::to_string(band + 1);
+        eq_freq[band]->u_param = new juce::AudioParameterFloat("EQ " + number + " freq", "eq " + number + " freq", eq_freq_range, eq_default_freqs[band]);
+        eq_gain[band]->u_param = new juce::AudioParameterFloat("EQ " + number + " gain", "eq " + number + " gain", eq_gain_range, 0.0);
+        eq_q[band]->u_param = new juce::AudioParameterFloat("EQ " + number + " Q", "eq " + number + " Q", eq_q_range, 0.7);
+    }
+    
+    for (int i = 0; i < NUM_STORED_PARAMETERS; ++i) {
         addParameter(params[i]->u_param);
     }
+    eq_placement_param = new juce::AudioParameterChoice("EQ placement", "eq placement",
+                                                        {"Pre-delay", "Feedback", "Post"}, eq_in_feedback);
+    addParameter(eq_placement_param);
     
-    delay_buffer = juce::AudioBuffer<float>();
-        
-    samples_since_reset = 0;
+    juce::StringArray note_values;
+    for (int i = 0; i < NUM_NOTE_VALUES; ++i) {
+        note_values.add(note_value_names[i]);
+    }
+    rate_sync_param = new juce::AudioParameterChoice("Rate sync", "rate sync", note_values, 0);
+    delay_sync_param = new juce::AudioParameterChoice("Delay sync", "delay sync", note_values, 0);
+    addParameter(rate_sync_param);
+    addParameter(delay_sync_param);
+    
+    engine_param = new juce::AudioParameterChoice("Engine", "engine", {"Sawtooth", "Overlap-add", "Spectral", "Trajectory"},
+                                                  engine_sawtooth);
+    overlap_param = new juce::AudioParameterInt("Overlap", "overlap", 2, max_heads, 2);
+    addParameter(engine_param);
+    addParameter(overlap_param);
+    shape_param = new juce::AudioParameterChoice("Trajectory", "trajectory",
+                                                 {"Sawtooth", "Triangle", "Stepped", "Random walk", "Drawn"}, shape_sawtooth);
+    addParameter(shape_param);
+    stereo_feedback_param = new juce::AudioParameterChoice("Stereo feedback", "stereo feedback",
+                                                           {"Normal", "Ping-pong", "Mid/side", "Width"}, stereo_normal);
+    feedback_width_param = new juce::AudioParameterFloat("Feedback width", "feedback width",
+                                                         juce::NormalisableRange<float> (0.0f, max_feedback_width), 1.0f);
+    addParameter(stereo_feedback_param);
+    addParameter(feedback_width_param);
+    saturation_param = new juce::AudioParameterChoice("Saturation", "saturation",
+                                                      {"Off", "First-order ADAA", "Second-order ADAA"}, 0);
+    drive_param = new juce::AudioParameterFloat("Drive", "drive",
+                                                juce::NormalisableRange<float> (0.0f, max_saturation_drive), 0.0f);
+    addParameter(saturation_param);
+    addParameter(drive_param);
+    delay_change_param = new juce::AudioParameterChoice("Delay change", "delay change", {"Glide", "Jump"}, delay_glide);
+    glide_time_param = new juce::AudioParameterFloat("Glide time", "glide time",
+                                                     juce::NormalisableRange<float> (min_glide_time, max_glide_time), 0.5f);
+    glide_curve_param = new juce::AudioParameterChoice("Glide curve", "glide curve", {"Linear", "Ease", "Exponential"},
+                                                       glide_linear);
+    addParameter(delay_change_param);
+    addParameter(glide_time_param);
+    addParameter(glide_curve_param);
+    key_mode_param = new juce::AudioParameterChoice("Key mode", "key mode", {"Off", "Next grain", "Immediate"}, key_off);
+    root_note_param = new juce::AudioParameterInt("Root note", "root note", 0, 127, 60);
+    addParameter(key_mode_param);
+    addParameter(root_note_param);
+    
+    current_program = 0;
+    for (int i = 0; i < NUM_PROGRAMS; ++i) {
+        program_names[i] = factory_programs[i].name;
+    }
+    program_sequence = 0;
+    program_switch_pending = false;
 }
 
 PitchDelayAudioProcessor::~PitchDelayAudioProcessor()
 {
+   #if SPLUTTER_PROFILE
+    // Whatever the zones recorded since the last export, from every instance.
+    std::ostringstream trace;
+    if (zone_profiler::writeChromeTrace(trace) > 0) {
+        juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("splutter-trace.json")
+            .replaceWithText(trace.str());
+    }
+   #endif
 }
 
 //==============================================================================
@@ -87,11 +200,8 @@ const juce::String PitchDelayAudioProcessor::getName() const
 
 bool PitchDelayAudioProcessor::acceptsMidi() const
 {
-   #if JucePlugin_WantsMidiInput
+    // For playing the pitch from keys (see key_mode_param).
     return true;
-   #else
-    return false;
-   #endif
 }
 
 bool PitchDelayAudioProcessor::producesMidi() const
@@ -119,65 +229,76 @@ double PitchDelayAudioProcessor::getTailLengthSeconds() const
 
 int PitchDelayAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    return NUM_PROGRAMS;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
+                           // so this should be at least 1, even if you're not really implementing programs.
 }
 
 int PitchDelayAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return current_program;
 }
 
 void PitchDelayAudioProcessor::setCurrentProgram (int index)
 {
+    if (index < 0 || index >= NUM_PROGRAMS) {
+        return;
+    }
+    current_program = index;
+    const FactoryProgram& program = factory_programs[index];
+    
+    ++program_sequence;
+    for (int i = 0; i < NUM_PARAMETERS; ++i) {
+        *(params[i]->u_param) = program.values[i];
+    }
+    for (int band = 0; band < NUM_EQ_BANDS; ++band) {
+        *(eq_freq[band]->u_param) = eq_default_freqs[band];
+        *(eq_gain[band]->u_param) = 0.0f;
+        *(eq_q[band]->u_param) = 0.7f;
+    }
+    *eq_placement_param = eq_in_feedback;
+    *rate_sync_param = 0;
+    *delay_sync_param = 0;
+    *engine_param = program.engine;
+    *overlap_param = program.overlap;
+    *shape_param = program.shape;
+    *stereo_feedback_param = stereo_normal;
+    *feedback_width_param = 1.0f;
+    *saturation_param = 0;
+    *drive_param = 0.0f;
+    *delay_change_param = delay_glide;
+    *glide_time_param = 0.5f;
+    *glide_curve_param = glide_linear;
+    program_switch_pending = true;
+    ++program_sequence;
 }
 
 const juce::String PitchDelayAudioProcessor::getProgramName (int index)
 {
-    return {};
+    if (index < 0 || index >= NUM_PROGRAMS) {
+        return {};
+    }
+    return program_names[index];
 }
 
 void PitchDelayAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    if (index >= 0 && index < NUM_PROGRAMS) {
+        program_names[index] = newName;
+    }
 }
 
 //==============================================================================
-
-void PitchDelayAudioProcessor::resizeBuffer()
-{
-    buffer_length = (int)(semitones_to_ratio(max_pitch_shift) * (fs * max_lfo_rate + smoothing_window) + max_delay_slider_val * fs);
-    std::cout<<"buffer length: "<<buffer_length<<"\n";
-    delay_buffer.setSize(NUM_CHANNELS, buffer_length, true, true, true);
-}
-
 void PitchDelayAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
-    fs = sampleRate;
-    samps_for_delay_move = fs * time_for_delay_move;
-    min_delay->a_param = *(min_delay->u_param) * fs;
-    min_delay_actual = min_delay->a_param;
-    
-    calculateParameters();
-
-    
-    old_max_delay = max_delay;
-    old_write_step = write_step;
-    old_lfo_len = lfo_len;
-    resizeBuffer();
-    delay_buffer.clear();
-    
-    
-    
-    delay_samples = lfo_rate->a_param;
-    buffer_write_pos = delay_samples;
+    readPlayHead();
+    readParameters();
+    engine.prepare(sampleRate);
+    setLatencySamples(engine.getLatencySamples());
 }
 
 void PitchDelayAudioProcessor::releaseResources()
 {
-    // When playback stops, you can use this as an opportunity to free up any
-    // spare memory, etc.
+    engine.release();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -206,144 +327,109 @@ bool PitchDelayAudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
 }
 #endif
 
-float PitchDelayAudioProcessor::semitones_to_ratio(float interval)
+void PitchDelayAudioProcessor::readPlayHead()
 {
-    return pow(2.0, interval / 12.0);
+    // Without a playing transport, synced values still follow the last tempo
+    // we saw, but the grains run free.
+    double bpm = 0;
+    double ppq = 0;
+    bool playing = false;
+    if (auto* play_head = getPlayHead()) {
+        if (auto position = play_head->getPosition()) {
+            if (auto host_bpm = position->getBpm()) {
+                bpm = *host_bpm;
+            }
+            if (auto host_ppq = position->getPpqPosition()) {
+                ppq = *host_ppq;
+                playing = position->getIsPlaying();
+            }
+        }
+    }
+    engine.setTransport(bpm, ppq, playing);
 }
 
-void PitchDelayAudioProcessor::calculateParameters()
+void PitchDelayAudioProcessor::readParameters()
 {
-    feedback_level->a_param = *(feedback_level->u_param);
-    dry_wet->a_param = *(dry_wet->u_param);
-        
-    // lfo rate a param: number of samples per saw
-    lfo_rate->a_param = *(lfo_rate->u_param) * fs;
-    
-    // how much will the read pointer move per sample?
-    pitch_shift->a_param = semitones_to_ratio(*(pitch_shift->u_param));
-
-    min_delay->a_param = *(min_delay->u_param) * fs;
-    if (min_delay_actual != min_delay->a_param) {
-        float distance = min_delay->a_param - min_delay_actual;
-        min_delay_step = distance / samps_for_delay_move;
+    EngineParameters& parameters = engine.parameters;
+    parameters.feedback = *(feedback_level->u_param);
+    parameters.dry_wet = *(dry_wet->u_param);
+    parameters.pitch_shift = *(pitch_shift->u_param);
+    parameters.rate = *(lfo_rate->u_param);
+    parameters.min_delay = *(min_delay->u_param);
+    parameters.lo_cut = *(lo_cut->u_param);
+    parameters.hi_cut = *(hi_cut->u_param);
+    for (int band = 0; band < NUM_EQ_BANDS; ++band) {
+        parameters.eq_freq[band] = *(eq_freq[band]->u_param);
+        parameters.eq_gain[band] = *(eq_gain[band]->u_param);
+        parameters.eq_q[band] = *(eq_q[band]->u_param);
     }
-    
-    // We don't want to change the shape of the sawtooth while we are in the
-    // middle of transitioning, that will cause clicking.
-    std::cout << samples_since_reset<<" samples since reset ";
-    if (samples_since_reset > 1000 || samples_since_reset == 0) {
-        lfo_len = lfo_rate->a_param;
-        write_step = pitch_shift->a_param - 1;
-        // max delay: maximum number of samples between read pointer and write pointer
-        if (pitch_shift->a_param == 1) {
-            // no pitch up or down.
-            max_delay = lfo_rate->a_param;
-        } else {
-            max_delay = abs(pitch_shift->a_param - 1) * lfo_rate->a_param;
-        }
-    }
-    std::cout<<write_step<<" "<<lfo_len<<"\n";
-    for (int i = 0; i < NUM_PARAMETERS; ++i) {
-        params[i]->curr_val = params[i]->a_param;
-    }
-    
-    float coeffs[5];
-    float fc = *(lo_cut->u_param);
-    float Q = 1.0;
-    FilterCalc::calcCoeffsHPF(coeffs, fc, Q, fs);
-    filter_lo_L.setCoefficients(coeffs[0], coeffs[1], coeffs[2], coeffs[3], coeffs[4]);
-    filter_lo_R.setCoefficients(coeffs[0], coeffs[1], coeffs[2], coeffs[3], coeffs[4]);
-    
-    fc = *(hi_cut->u_param);
-    FilterCalc::calcCoeffsLPF(coeffs, fc, Q, fs);
-    filter_hi_L.setCoefficients(coeffs[0], coeffs[1], coeffs[2], coeffs[3], coeffs[4]);
-    filter_hi_R.setCoefficients(coeffs[0], coeffs[1], coeffs[2], coeffs[3], coeffs[4]);
+    parameters.eq_placement = eq_placement_param->getIndex();
+    parameters.rate_sync = *rate_sync_param;
+    parameters.delay_sync = *delay_sync_param;
+    parameters.engine = *engine_param;
+    parameters.overlap = *overlap_param;
+    parameters.shape = *shape_param;
+    parameters.stereo_feedback = *stereo_feedback_param;
+    parameters.feedback_width = *feedback_width_param;
+    parameters.saturation = saturation_param->getIndex();
+    parameters.drive = *drive_param;
+    parameters.delay_change = delay_change_param->getIndex();
+    parameters.glide_time = *glide_time_param;
+    parameters.glide_curve = glide_curve_param->getIndex();
+    parameters.key_mode = key_mode_param->getIndex();
+    parameters.root_note = *root_note_param;
 }
 
-float PitchDelayAudioProcessor::getInBetween(const float* buffer, const float index)
+void PitchDelayAudioProcessor::setDrawnTrajectory(const float* points, int numPoints)
 {
-    // Currently linear interpolation, maybe i should do more.
-    int lower_index = index;
-    float offset = index - lower_index;
-    return buffer[lower_index] * (1 - offset) + (offset) * buffer[lower_index + 1];
+    engine.setDrawnTrajectory(points, numPoints);
 }
 
+bool PitchDelayAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
 
-float PitchDelayAudioProcessor::linInterpolation(const float start, const float end, const float fract)
+void PitchDelayAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
-    return start + (fract * (end - start));
+    processWithEngine(buffer, midiMessages, false);
 }
 
-float PitchDelayAudioProcessor::getRPointer(int s, float w_ptr, float step, float max, bool is_secondary)
+void PitchDelayAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
 {
-    float secondary_shift;
-    if (is_secondary) {
-        secondary_shift = max;
-    } else {
-        secondary_shift = 0;
-    }
-    float r_ptr;
-    if (step < 0) {
-        r_ptr = w_ptr + ((float)s) * step - secondary_shift - min_delay_actual;
-    } else if (step > 0) {
-        // we need to buffer the read pointer away from the write pointer by the smoothing window,
-        // so that the secondary read pointer in the smoothing window doesn't go past the write pointer
-        r_ptr = w_ptr - max + ((float)s) * step - smoothing_window + secondary_shift - min_delay_actual;
-    } else {
-        r_ptr = w_ptr - min_delay_actual; // No secondary shift for constant delay.
-    }
-    return r_ptr;
+    processWithEngine(buffer, midiMessages, false);
 }
 
-float PitchDelayAudioProcessor::getWetSaw(const int s, const float w_ptr, const float* delay_channel)
+void PitchDelayAudioProcessor::processBlockBypassed (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
-    float r_ptr, secondary_r_ptr;
-    if (s > smoothing_window || (write_step == 0 && old_write_step == 0)) {
-        r_ptr = getRPointer(s, w_ptr, old_write_step, old_max_delay, false);
-        //std::cout<<r_ptr<<"\n";
-        if (r_ptr < 0) {
-            r_ptr += buffer_length;
-        }
-        return getInBetween(delay_channel, r_ptr);
-    } else {
-        r_ptr = getRPointer(s, w_ptr, write_step, max_delay, false);
-        secondary_r_ptr = getRPointer(s, w_ptr, old_write_step, old_max_delay, true);
-        if (r_ptr < 0) {
-            r_ptr += buffer_length;
-        }
-        if (secondary_r_ptr < 0) {
-            secondary_r_ptr += buffer_length;
-        }
-        // For the smallest values of s, we use a "smoothing window": we calculate the values from
-        // where the read pointer would be if it had continued its trajectory, and fade from the old
-        // values to the new values.
-        
-        // Normally, we want to preserve power across the transiton. However, if we are
-        // Not shifting the pitch up or down, we want to preserve
-        float r_scale = sin( PI *(((float)s) / (float)smoothing_window) / 2.0);
-        float secondary_scale = cos( PI *(((float)s) / (float)smoothing_window) / 2);
-        //std::cout<<r_ptr<<" at "<<r_scale<<"; "<<secondary_r_ptr<<" at "<<secondary_scale<<"\n";
-        return r_scale * getInBetween(delay_channel, r_ptr) +
-            secondary_scale * getInBetween(delay_channel, secondary_r_ptr);
-    }
+    processWithEngine(buffer, midiMessages, true);
 }
 
-void PitchDelayAudioProcessor::adjustMinDelayActual() {
-    if (abs(min_delay_actual - min_delay->a_param) < abs(min_delay_step)) {
-        min_delay_actual = min_delay->a_param;
-    } else {
-        min_delay_actual += min_delay_step;
+void PitchDelayAudioProcessor::processBlockBypassed (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processWithEngine(buffer, midiMessages, true);
+}
+
+void PitchDelayAudioProcessor::readKeys(const juce::MidiBuffer& midiMessages)
+{
+    for (const auto metadata : midiMessages) {
+        const juce::MidiMessage message = metadata.getMessage();
+        if (message.isNoteOn()) {
+            engine.addKeyEvent(metadata.samplePosition, message.getNoteNumber(), true);
+        } else if (message.isNoteOff()) {
+            engine.addKeyEvent(metadata.samplePosition, message.getNoteNumber(), false);
+        } else if (message.isAllNotesOff() || message.isAllSoundOff()) {
+            engine.addKeyEvent(metadata.samplePosition, all_keys, false);
+        }
     }
 }
 
-void PitchDelayAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+template <typename SampleType>
+void PitchDelayAudioProcessor::processWithEngine (juce::AudioBuffer<SampleType>& buffer, const juce::MidiBuffer& midiMessages,
+                                                  bool bypass)
 {
-    calculateParameters();
-    
-    juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
-    const int numSamples = buffer.getNumSamples();
 
     // In case we have more outputs than inputs, this code clears any output
     // channels that didn't contain input data, (because these aren't
@@ -353,87 +439,31 @@ void PitchDelayAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, j
     // this code if your algorithm always overwrites all the output channels.
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
-
-    // This is the place where you'd normally do the guts of your plugin's
-    // audio processing...
-    // Make sure to reset the state if your inner loop is processing
-    // the samples and the outer loop is handling the channels.
-    // Alternatively, you can process the samples with the channels
-    // interleaved by keeping the same state.
-    float fract;
-    long w_ptr;
-    int s;
-    float dry, wet, out, in, d_samp;
-    float oll = old_lfo_len;
-    float omd = old_max_delay;
-    float ows = old_write_step;
-    float mda = min_delay_actual;
-    for (int channel = 0; channel < fmin(NUM_CHANNELS, totalNumInputChannels); ++channel)
-    {
-        min_delay_actual = mda;
-        old_lfo_len = oll;
-        old_max_delay = omd;
-        old_write_step = ows;
-        float* delay_channel = delay_buffer.getWritePointer(channel);
-        
-        w_ptr = buffer_write_pos;
-        d_samp = delay_samples;
-        s = samples_since_reset;
-        
-        auto* channelData = buffer.getWritePointer (channel);
-        
-        for (int sample = 0; sample < numSamples; ++sample) {
-            
-            fract = ((float) sample / (float) numSamples);
-            for (int i = 0; i < NUM_PARAMETERS; ++i) {
-                if (params[i]->curr_val != params[i]->prev_val) {
-                    params[i]->a_param = linInterpolation(params[i]->prev_val, params[i]->curr_val, fract);
-                }
-            }
-
-            in = channelData[sample];
-            delay_channel[w_ptr] = in;
-            // This is necessary for when the delay time is set to 0.
-            
-            wet = getWetSaw(s, w_ptr, delay_channel);
-            dry = in;
-            out = wet * (dry_wet->a_param) + dry * (1 - dry_wet->a_param);
-            if (out != 0) {
-                std::cout<<s<< " " <<out<<"\n";
-            }
-            float unfiltered = wet * feedback_level->a_param + in;
-            if (channel == 0) {
-                delay_channel[w_ptr] = filter_lo_L.tick(filter_hi_L.tick(unfiltered));
-                //delay_channel[w_ptr] = unfiltered;
-            } else if (channel == 1) {
-                delay_channel[w_ptr] = filter_lo_R.tick(filter_hi_R.tick(unfiltered));
-                //delay_channel[w_ptr] = unfiltered;
-            }
-            channelData[sample] = out;
-            
-            // every sample, the write position in the delay array steps forward one
-            w_ptr++;
-            if (w_ptr >= buffer_length) {
-                w_ptr = 0;
-            }
-            s++;
-            if (s == smoothing_window) {
-                old_lfo_len = lfo_len;
-                old_max_delay = max_delay;
-                old_write_step = write_step;
-            }
-            if (s >= old_lfo_len) {
-                s = 0;
-            }
-            adjustMinDelayActual();
-        }
-        for (int i = 0; i < NUM_PARAMETERS; ++i) {
-            params[i]->prev_val = params[i]->curr_val;
-        }
+    
+    // A new program waits until every parameter is in.
+    readPlayHead();
+    const uint32_t sequence = program_sequence;
+    bool loading = (sequence & 1) != 0;
+    if (! loading) {
+        readParameters();
+        // setCurrentProgram may have started in the middle of the reads.
+        loading = program_sequence != sequence;
+    }
+    if (! loading && program_switch_pending.exchange(false)) {
+        engine.switchProgram();
+    }
+    engine.holdParameters(loading);
+    readKeys(midiMessages);
+    
+    const int numChannels = std::min(totalNumInputChannels, buffer.getNumChannels());
+    if (bypass) {
+        engine.processBypassed(buffer.getArrayOfWritePointers(), numChannels, buffer.getNumSamples());
+    } else {
+        engine.process(buffer.getArrayOfWritePointers(), numChannels, buffer.getNumSamples());
+    }
+    if (engine.getLatencySamples() != getLatencySamples()) {
+        setLatencySamples(engine.getLatencySamples());
     }
-    samples_since_reset = s;
-    buffer_write_pos = w_ptr;
-    delay_samples = d_samp;
 }
 
 //==============================================================================
@@ -453,24 +483,106 @@ void PitchDelayAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
     // You should use this method to store your parameters in the memory block.
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
-    std::unique_ptr<juce::XmlElement> xml (new juce::XmlElement ("sliderParams"));
-    for (int i = 0; i < NUM_PARAMETERS; ++i) {
-        xml->setAttribute(juce::Identifier(params[i]->name),
-                          (double) *(params[i]->u_param));
+    StateWriter writer;
+    for (int i = 0; i < NUM_STORED_PARAMETERS; ++i) {
+        writer.addFloat(state_tag_params + i, *(params[i]->u_param));
     }
-    copyXmlToBinary (*xml, destData);
+    writer.addInt(state_tag_eq_placement, eq_placement_param->getIndex());
+    writer.addInt(state_tag_rate_sync, rate_sync_param->getIndex());
+    writer.addInt(state_tag_delay_sync, delay_sync_param->getIndex());
+    writer.addInt(state_tag_engine, engine_param->getIndex());
+    writer.addInt(state_tag_overlap, overlap_param->get());
+    writer.addInt(state_tag_program, current_program);
+    writer.addInt(state_tag_trajectory_shape, shape_param->getIndex());
+    writer.addInt(state_tag_stereo_feedback, stereo_feedback_param->getIndex());
+    writer.addFloat(state_tag_feedback_width, *feedback_width_param);
+    writer.addInt(state_tag_saturation, saturation_param->getIndex());
+    writer.addFloat(state_tag_saturation_drive, *drive_param);
+    writer.addInt(state_tag_delay_change, delay_change_param->getIndex());
+    writer.addFloat(state_tag_glide_time, *glide_time_param);
+    writer.addInt(state_tag_glide_curve, glide_curve_param->getIndex());
+    writer.addInt(state_tag_key_mode, key_mode_param->getIndex());
+    writer.addInt(state_tag_root_note, root_note_param->get());
+    float drawn_points[max_drawn_points];
+    writer.addFloats(state_tag_drawn_trajectory, drawn_points, engine.getDrawnTrajectory(drawn_points));
+    const uint8_t* data = writer.finish();
+    destData.replaceAll(data, writer.getSize());
 }
 
 void PitchDelayAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
+    // The binary state is read where it lies, without allocating. Fields it
+    // doesn't have, or doesn't know, leave the current values alone.
+    StateReader reader;
+    if (reader.open(data, sizeInBytes)) {
+        while (reader.next()) {
+            const int tag = reader.getTag();
+            float value;
+            int32_t index;
+            if (tag >= state_tag_params && tag < state_tag_params + NUM_STORED_PARAMETERS) {
+                if (reader.getFloat(value)) {
+                    *(params[tag - state_tag_params]->u_param) = value;
+                }
+            } else if (tag == state_tag_feedback_width) {
+                if (reader.getFloat(value)) {
+                    *feedback_width_param = value;
+                }
+            } else if (tag == state_tag_saturation_drive) {
+                if (reader.getFloat(value)) {
+                    *drive_param = value;
+                }
+            } else if (tag == state_tag_glide_time) {
+                if (reader.getFloat(value)) {
+                    *glide_time_param = value;
+                }
+            } else if (tag == state_tag_drawn_trajectory) {
+                float points[max_drawn_points];
+                int count = reader.getFloats(points, max_drawn_points);
+                if (count >= 0) {
+                    setDrawnTrajectory(points, count);
+                }
+            } else if (reader.getInt(index)) {
+                switch (tag) {
+                    case state_tag_eq_placement: *eq_placement_param = index; break;
+                    case state_tag_rate_sync:    *rate_sync_param = index; break;
+                    case state_tag_delay_sync:   *delay_sync_param = index; break;
+                    case state_tag_engine:       *engine_param = index; break;
+                    case state_tag_overlap:      *overlap_param = index; break;
+                    case state_tag_trajectory_shape: *shape_param = index; break;
+                    case state_tag_stereo_feedback: *stereo_feedback_param = index; break;
+                    case state_tag_saturation:   *saturation_param = index; break;
+                    case state_tag_delay_change: *delay_change_param = index; break;
+                    case state_tag_glide_curve:  *glide_curve_param = index; break;
+                    case state_tag_key_mode:     *key_mode_param = index; break;
+                    case state_tag_root_note:    *root_note_param = index; break;
+                    case state_tag_program:
+                        // Only the number: the parameters saved with it win.
+                        if (index >= 0 && index < NUM_PROGRAMS) {
+                            current_program = index;
+                        }
+                        break;
+                    default: break;
+                }
+            }
+        }
+        return;
+    }
+    
+    // Sessions saved before the binary state hold an XML element instead.
     std::unique_ptr<juce::XmlElement> xmlState (getXmlFromBinary(data, sizeInBytes));
     
     if ((xmlState != nullptr) && (xmlState->hasTagName("sliderParams"))) {
-        for (int i = 0; i < NUM_PARAMETERS; ++i) {
-            *(params[i]->u_param) = xmlState->getDoubleAttribute(params[i]->name,0.0);
+        // Parameters missing from older sessions keep their current value.
+        for (int i = 0; i < NUM_STORED_PARAMETERS; ++i) {
+            *(params[i]->u_param) = xmlState->getDoubleAttribute(params[i]->name, *(params[i]->u_param));
         }
+        *eq_placement_param = xmlState->getIntAttribute("eqplacement", eq_in_feedback);
+        *rate_sync_param = xmlState->getIntAttribute("ratesync", 0);
+        *delay_sync_param = xmlState->getIntAttribute("delaysync", 0);
+        *engine_param = xmlState->getIntAttribute("engine", engine_sawtooth);
+        *overlap_param = xmlState->getIntAttribute("overlap", 2);
     }
 }
 
@@ -14,41 +14,44 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "filterCalc/FilterCalc.h"
-#include "stk-filters/BiQuad.h"
-#include <math.h> // pow
-#include <algorithm> // min, max
-#include <iostream>
-#include <stdlib.h> // abs
-
-#define PI 3.14159265
-#define NUM_PARAMETERS 7
-#define NUM_CHANNELS 2
-#define GET_IN_RANGE(sample) (sample += (sample < 0) ? buffer_length : 0)
-
-const float max_lfo_rate = 4.0;
-const float max_pitch_shift = 3.0 * 12.0;
-const float max_delay_slider_val = 4.0;
-
-const int smoothing_window = 1000;
-// over how many samples do we fade from the near to the far sound on
-// the sawtooth delay?
+#include "core/SplutterEngine.h"
+#include "state/StateCodec.h"
+#include <atomic>
+
+#define NUM_PROGRAMS 9
+
+// Field tags in the saved state (see StateCodec.h). The stored float
+// parameters take state_tag_params + their index in params, so that order is
+// part of the format too: new parameters go on the end.
+enum StateTag {
+    state_tag_params = 1,
+    state_tag_eq_placement = 64,
+    state_tag_rate_sync,
+    state_tag_delay_sync,
+    state_tag_engine,
+    state_tag_overlap,
+    state_tag_program,
+    state_tag_trajectory_shape,
+    state_tag_drawn_trajectory,
+    state_tag_stereo_feedback,
+    state_tag_feedback_width,
+    state_tag_saturation,
+    state_tag_saturation_drive,
+    state_tag_delay_change,
+    state_tag_glide_time,
+    state_tag_glide_curve,
+    state_tag_key_mode,
+    state_tag_root_note
+};
 
+// A host parameter. The engine gets the values in its EngineParameters each
+// block, and ramps them itself.
 struct ParameterVals {
     juce::AudioParameterFloat* u_param;
-    float a_param;
-    
-    // Interpolation parameters
-    float curr_val;
-    float prev_val;
     int param_code;
     std::string name;
-    
-    ParameterVals(): a_param(0), curr_val(0), prev_val(0) {}
 };
 
-
-
 //==============================================================================
 /**
 */
@@ -70,6 +73,10 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    void processBlockBypassed (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlockBypassed (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -102,44 +109,61 @@ public:
     ParameterVals* lo_cut;
     ParameterVals* hi_cut;
     
-    ParameterVals* params[NUM_PARAMETERS];
+    // Parametric EQ in the feedback loop: a low shelf, two peaks and a high
+    // shelf. Only coefficients are updated per block, so these are not
+    // interpolated per sample like the first NUM_PARAMETERS params.
+    ParameterVals* eq_freq[NUM_EQ_BANDS];
+    ParameterVals* eq_gain[NUM_EQ_BANDS];
+    ParameterVals* eq_q[NUM_EQ_BANDS];
     
+    // The first NUM_PARAMETERS entries are interpolated per sample, the rest
+    // are only saved and restored with the plugin state.
+    ParameterVals* params[NUM_STORED_PARAMETERS];
     
-private:
-    int fs; // Sample frequency
-    juce::AudioBuffer<float> delay_buffer;
-    float buffer_read_pos;
-    long buffer_write_pos;
-    float delay_samples;
-    int samples_since_reset;
-    
-    int buffer_length;
+    juce::AudioParameterChoice* eq_placement_param;
+    juce::AudioParameterChoice* rate_sync_param;
+    juce::AudioParameterChoice* delay_sync_param;
+    juce::AudioParameterChoice* engine_param;
+    juce::AudioParameterInt* overlap_param; // heads for the overlap-add engine
+    juce::AudioParameterChoice* shape_param; // the trajectory engine's TrajectoryShape
+    juce::AudioParameterChoice* stereo_feedback_param; // StereoFeedback
+    juce::AudioParameterFloat* feedback_width_param;   // for stereo_width
+    juce::AudioParameterChoice* saturation_param; // off, or the ADAA order
+    juce::AudioParameterFloat* drive_param;       // dB
+    juce::AudioParameterChoice* delay_change_param; // DelayChange
+    juce::AudioParameterFloat* glide_time_param;    // seconds
+    juce::AudioParameterChoice* glide_curve_param;  // GlideCurve
+    // Playing the pitch from MIDI keys. These aren't part of the programs,
+    // which only set the sound.
+    juce::AudioParameterChoice* key_mode_param; // KeyMode
+    juce::AudioParameterInt* root_note_param;   // the key that plays no shift
     
-    float write_step;
-    float lfo_len;
-    float max_delay;
+    // Sends a curve for the drawn trajectory shape: numPoints evenly spaced
+    // values from 0 to 1 (at most max_drawn_points), across one grain. Call
+    // from the message thread; it never waits for the audio thread.
+    void setDrawnTrajectory(const float* points, int numPoints);
     
-    float old_write_step;
-    float old_lfo_len;
-    float old_max_delay;
-    
-    float min_delay_actual;
-    float min_delay_step;
-    const float time_for_delay_move = 0.5; // seconds
-    float samps_for_delay_move;
     
+private:
+    // The DSP, shared with the C API (core/splutter.h). Everything here is the
+    // plugin around it: parameters, programs, state and the host transport.
+    SplutterEngine engine;
     
-    float lo_freq, hi_freq;
-    stk::BiQuad filter_lo_L, filter_lo_R, filter_hi_L, filter_hi_R;
+    // Programs. setCurrentProgram bumps program_sequence before and after it
+    // sets every parameter, so the count is odd while a program is loading.
+    // A block that finds it odd, or changed while the parameters were read,
+    // holds on to the old values, and the switch, which the engine fades
+    // across, waits for a block that reads the whole new program.
+    int current_program;
+    juce::String program_names[NUM_PROGRAMS];
+    std::atomic<uint32_t> program_sequence;
+    std::atomic<bool> program_switch_pending;
     
-    float semitones_to_ratio(float interval);
-    void resizeBuffer();
-    void calculateParameters();
-    float getInBetween(const float* buffer, const float index);
-    float linInterpolation(float start, float end, float fract);
-    float getWetSaw(const int s, const float w_ptr, const float* delay_channel);
-    float getRPointer(int s, float w_ptr, float step, float max, bool is_secondary);
-    void adjustMinDelayActual();
+    void readPlayHead();
+    void readParameters();
+    void readKeys(const juce::MidiBuffer& midiMessages);
+    template <typename SampleType>
+    void processWithEngine(juce::AudioBuffer<SampleType>& buffer, const juce::MidiBuffer& midiMessages, bool bypass);
     
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PitchDelayAudioProcessor)
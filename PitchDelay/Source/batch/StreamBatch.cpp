@@ -0,0 +1,525 @@
+/*
+  ==============================================================================
+
+    StreamBatch.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "StreamBatch.h"
+#include "../core/FlushDenormals.h"
+#include <chrono>
+#include <cstring>
+
+// GCC only turns the lane loop into SIMD when it is a loop of its own, not
+// the inner loop of processSegment's sample loop, so readLanes stays a call.
+#if defined (_MSC_VER)
+ #define BATCH_NOINLINE __declspec(noinline)
+#else
+ #define BATCH_NOINLINE __attribute__((noinline))
+#endif
+
+// The grain crossfade's equal-power gains, indexed by s, with one more entry
+// past the end for lanes that aren't crossfading, so the kernel can look
+// every lane up without a branch.
+struct BatchCrossfadeTable {
+    float fade_in[smoothing_window + 1];
+    float fade_out[smoothing_window + 1];
+
+    BatchCrossfadeTable() {
+        for (int s = 0; s < smoothing_window; ++s) {
+            fade_in[s] = sin( PI *(((float)s) / (float)smoothing_window) / 2.0);
+            fade_out[s] = cos( PI *(((float)s) / (float)smoothing_window) / 2);
+        }
+        fade_in[smoothing_window] = 1.0f;
+        fade_out[smoothing_window] = 0.0f;
+    }
+};
+static const BatchCrossfadeTable batch_crossfade;
+
+static inline float readHistory(const float* history, int32_t offset, int32_t length, double position)
+{
+    // Positions are within a length either side of the history, so shifting
+    // them up by one makes the truncation a floor, and the wrap is done on
+    // the index, where the compiler keeps it branch free.
+    position += length;
+    int32_t index = (int32_t) position;
+    const float fraction = (float) (position - index);
+    index -= index >= length ? length : 0;
+    index -= index >= length ? length : 0;
+    // Indexing the slab itself, not a pointer per lane, lets the reads
+    // across the lanes become one gather.
+    return history[offset + index] * (1 - fraction) + fraction * history[offset + index + 1];
+}
+
+static inline int roundUpToLine(int samples)
+{
+    return (samples + 15) & ~15;
+}
+
+//==============================================================================
+StreamBatch::StreamBatch(double sampleRate, int maxStreams, size_t slabBytes)
+{
+    fs = sampleRate;
+    samps_for_delay_move = fs * 0.5f;
+    num_streams = 0;
+    groups_in_use = 0;
+    dirty_cleared = 0;
+    resetThroughput();
+
+    // Offsets into the slab are 32-bit, so they gather as one vector.
+    slabBytes = std::min(slabBytes, (size_t) INT32_MAX * sizeof(float));
+    slab = HistoryPool::getInstance().acquire(slabBytes);
+    history = static_cast<float*>(slab.data);
+
+    groups.resize((std::max(maxStreams, 1) + width - 1) / width);
+    for (StreamGroup& group : groups) {
+        group.active = 0;
+        for (int lane = 0; lane < width; ++lane) {
+            setIdle(group, lane);
+        }
+    }
+
+    free_ranges.reserve(getCapacity() + 1);
+    dirty_ranges.reserve(getCapacity());
+    if (history != nullptr) {
+        const int32_t total = (int32_t) (slab.bytes / sizeof(float));
+        const int32_t reserved = roundUpToLine(idle_length + 1);
+        if (total > reserved) {
+            free_ranges.push_back({ reserved, total - reserved });
+        }
+    }
+}
+
+StreamBatch::~StreamBatch()
+{
+    HistoryPool::getInstance().release(slab);
+}
+
+int StreamBatch::getHistorySize(const StreamLimits& limits) const
+{
+    // The furthest back a read goes: the longest min delay, plus a whole
+    // grain's sweep, plus the old grain carrying on through the crossfade.
+    const double step = pow(2.0, limits.pitch_range / 12.0) - 1;
+    const double grain = std::max(limits.longest_grain * fs, smoothing_window + 1.0);
+    const double furthest = limits.longest_delay * fs + step * grain + smoothing_window * (1 + step);
+    return roundUpToLine((int) ceil(furthest) + 2 + 1); // and the guard sample
+}
+
+int StreamBatch::takeRange(int size)
+{
+    // First fit. Streams come and go at random, so a smarter fit buys little.
+    for (size_t i = 0; i < free_ranges.size(); ++i) {
+        SlabRange& range = free_ranges[i];
+        if (range.size >= size) {
+            const int offset = range.offset;
+            range.offset += size;
+            range.size -= size;
+            if (range.size == 0) {
+                free_ranges.erase(free_ranges.begin() + i);
+            }
+            return offset;
+        }
+    }
+    return -1;
+}
+
+void StreamBatch::giveRange(SlabRange range)
+{
+    // Merged with its neighbours, so there are never more ranges than streams
+    // plus one and the reserve holds.
+    size_t i = 0;
+    while (i < free_ranges.size() && free_ranges[i].offset < range.offset) {
+        ++i;
+    }
+    if (i > 0 && free_ranges[i - 1].offset + free_ranges[i - 1].size == range.offset) {
+        free_ranges[i - 1].size += range.size;
+        if (i < free_ranges.size() && range.offset + range.size == free_ranges[i].offset) {
+            free_ranges[i - 1].size += free_ranges[i].size;
+            free_ranges.erase(free_ranges.begin() + i);
+        }
+    } else if (i < free_ranges.size() && range.offset + range.size == free_ranges[i].offset) {
+        free_ranges[i].offset = range.offset;
+        free_ranges[i].size += range.size;
+    } else {
+        free_ranges.insert(free_ranges.begin() + i, range);
+    }
+}
+
+void StreamBatch::clearDirtyRanges()
+{
+    // Oldest first. dirty_cleared is how much of the first one is done.
+    int budget = clear_budget;
+    while (budget > 0 && ! dirty_ranges.empty()) {
+        const SlabRange range = dirty_ranges.front();
+        const int samples = std::min(budget, (int) range.size - dirty_cleared);
+        std::memset(history + range.offset + dirty_cleared, 0, samples * sizeof(float));
+        dirty_cleared += samples;
+        budget -= samples;
+        if (dirty_cleared == range.size) {
+            dirty_ranges.erase(dirty_ranges.begin());
+            dirty_cleared = 0;
+            giveRange(range);
+        }
+    }
+}
+
+//==============================================================================
+void StreamBatch::setIdle(StreamGroup& group, int lane)
+{
+    // Reads stay inside the untouched stretch at the start of the slab, and
+    // nothing is written, so the lane can run along with the others.
+    group.offset[lane] = 0;
+    group.length[lane] = idle_length;
+    group.w_ptr[lane] = 0;
+    group.since_reset[lane] = smoothing_window;
+    group.grain_len[lane] = smoothing_window + 1;
+    group.min_delay_steps_left[lane] = 0;
+    group.write_step[lane] = 0;
+    group.base[lane] = 0;
+    group.old_write_step[lane] = 0;
+    group.old_base[lane] = 0;
+    group.min_delay[lane] = 0;
+    group.min_delay_step[lane] = 0;
+    group.min_delay_target[lane] = 0;
+    group.feedback[lane] = 0;
+    group.feedback_inc[lane] = 0;
+    group.wet[lane] = 0;
+    group.wet_inc[lane] = 0;
+}
+
+StreamSettings StreamBatch::clampSettings(const StreamSettings& settings, const StreamLimits& limits) const
+{
+    StreamSettings clamped;
+    clamped.feedback = std::min(std::max(settings.feedback, 0.0f), 0.95f);
+    clamped.dry_wet = std::min(std::max(settings.dry_wet, 0.0f), 1.0f);
+    clamped.pitch_shift = std::min(std::max(settings.pitch_shift, -limits.pitch_range), limits.pitch_range);
+    clamped.rate = std::min(std::max(settings.rate, min_lfo_rate), limits.longest_grain);
+    clamped.min_delay = std::min(std::max(settings.min_delay, 0.0f), limits.longest_delay);
+    return clamped;
+}
+
+void StreamBatch::setMinDelayTarget(StreamGroup& group, int lane, bool glide)
+{
+    const double target = group.settings[lane].min_delay * fs;
+    if (target == group.min_delay_target[lane] && glide) {
+        return;
+    }
+    group.min_delay_target[lane] = target;
+    if (glide && target != group.min_delay[lane]) {
+        group.min_delay_steps_left[lane] = (int) samps_for_delay_move;
+        group.min_delay_step[lane] = (target - group.min_delay[lane]) / group.min_delay_steps_left[lane];
+    } else {
+        group.min_delay[lane] = target;
+        group.min_delay_step[lane] = 0;
+        group.min_delay_steps_left[lane] = 0;
+    }
+}
+
+void StreamBatch::startGrain(StreamGroup& group, int lane)
+{
+    // The grain that was playing carries on from where it got to while the
+    // new one fades in, as getRPointer's secondary pointer does.
+    const double old_step = group.write_step[lane];
+    const double old_depth = fabs(old_step) * group.grain_len[lane];
+    group.old_write_step[lane] = old_step;
+    group.old_base[lane] = group.base[lane] + (old_step < 0 ? old_depth : (old_step > 0 ? -old_depth : 0));
+
+    // Pitch and grain length only change here, at the start of a grain. A
+    // grain is never shorter than its crossfade.
+    const StreamSettings& settings = group.settings[lane];
+    const double step = pow(2.0, settings.pitch_shift / 12.0) - 1;
+    const int grain = std::max((int) (settings.rate * fs), smoothing_window + 1);
+    group.write_step[lane] = step;
+    group.grain_len[lane] = grain;
+    group.base[lane] = step > 0 ? step * grain + smoothing_window : 0;
+    // Unpitched on both sides, the two reads land on the same sample, and
+    // fading one into itself would boost it in the loop, so the grain
+    // starts past its crossfade, as getPitchRegime's pitch_unity does.
+    group.since_reset[lane] = step == 0 && old_step == 0 ? smoothing_window : 0;
+}
+
+int StreamBatch::addStream(const StreamSettings& settings, const StreamLimits& limits)
+{
+    if (! isAllocated()) {
+        return -1;
+    }
+    int group_index = 0;
+    const uint32_t full = (1u << width) - 1;
+    while (group_index < (int) groups.size() && groups[group_index].active == full) {
+        ++group_index;
+    }
+    if (group_index == (int) groups.size()) {
+        return -1;
+    }
+    const int size = getHistorySize(limits);
+    const int offset = takeRange(size);
+    if (offset < 0) {
+        return -1;
+    }
+
+    StreamGroup& group = groups[group_index];
+    int lane = 0;
+    while (group.active & (1u << lane)) {
+        ++lane;
+    }
+    group.active |= 1u << lane;
+    group.offset[lane] = offset;
+    group.length[lane] = size - 1;
+    group.w_ptr[lane] = 0;
+    group.limits[lane] = limits;
+    group.settings[lane] = clampSettings(settings, limits);
+    // The history is silent, so there is nothing for the first grain to
+    // fade in from.
+    group.write_step[lane] = 0;
+    group.base[lane] = 0;
+    group.grain_len[lane] = 0;
+    startGrain(group, lane);
+    group.since_reset[lane] = smoothing_window;
+    setMinDelayTarget(group, lane, false);
+    group.feedback[lane] = group.settings[lane].feedback;
+    group.wet[lane] = group.settings[lane].dry_wet;
+
+    ++num_streams;
+    groups_in_use = std::max(groups_in_use, group_index + 1);
+    return group_index * width + lane;
+}
+
+void StreamBatch::removeStream(int id)
+{
+    if (id < 0 || id >= getCapacity()) {
+        return;
+    }
+    StreamGroup& group = groups[id / width];
+    const int lane = id % width;
+    if ((group.active & (1u << lane)) == 0) {
+        return;
+    }
+    group.active &= ~(1u << lane);
+    dirty_ranges.push_back({ group.offset[lane], group.length[lane] + 1 });
+    setIdle(group, lane);
+    --num_streams;
+    while (groups_in_use > 0 && groups[groups_in_use - 1].active == 0) {
+        --groups_in_use;
+    }
+}
+
+void StreamBatch::setStream(int id, const StreamSettings& settings)
+{
+    if (id < 0 || id >= getCapacity()) {
+        return;
+    }
+    StreamGroup& group = groups[id / width];
+    const int lane = id % width;
+    if ((group.active & (1u << lane)) == 0) {
+        return;
+    }
+    group.settings[lane] = clampSettings(settings, group.limits[lane]);
+    setMinDelayTarget(group, lane, true);
+}
+
+//==============================================================================
+void StreamBatch::process(float* const* streams, int numSamples)
+{
+    if (! isAllocated() || numSamples <= 0) {
+        return;
+    }
+    ScopedFlushDenormals noDenormals;
+    const auto start = std::chrono::steady_clock::now();
+
+    int groups_processed = 0;
+    for (int group_index = 0; group_index < groups_in_use; ++group_index) {
+        StreamGroup& group = groups[group_index];
+        if (group.active == 0) {
+            continue;
+        }
+        processGroup(group, streams, group_index * width, numSamples);
+        ++groups_processed;
+    }
+
+    // Removed streams' histories can be reused once they are silent again.
+    clearDirtyRanges();
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    busy_seconds += elapsed.count();
+    stream_samples += (double) num_streams * numSamples;
+    lane_samples += (double) groups_processed * width * numSamples;
+}
+
+void StreamBatch::processGroup(StreamGroup& group, float* const* streams, int firstId, int numSamples)
+{
+    // The gains ramp across the whole block, like the plugin's.
+    for (int lane = 0; lane < width; ++lane) {
+        if (group.active & (1u << lane)) {
+            group.feedback_inc[lane] = (group.settings[lane].feedback - group.feedback[lane]) / numSamples;
+            group.wet_inc[lane] = (group.settings[lane].dry_wet - group.wet[lane]) / numSamples;
+        }
+    }
+
+    for (int chunk = 0; chunk < numSamples; chunk += max_chunk) {
+        const int chunk_length = std::min(max_chunk, numSamples - chunk);
+        // Lanes go side by side in frames, one frame per sample.
+        for (int lane = 0; lane < width; ++lane) {
+            const float* input = (group.active & (1u << lane)) ? streams[firstId + lane] : nullptr;
+            for (int sample = 0; sample < chunk_length; ++sample) {
+                frames[sample * width + lane] = input != nullptr ? input[chunk + sample] : 0.0f;
+            }
+        }
+
+        for (int sample = 0; sample < chunk_length;) {
+            bool crossfading;
+            const int length = getSegmentLength(group, chunk_length - sample, crossfading);
+            if (crossfading) {
+                processSegment<true>(group, frames + sample * width, chunk + sample, length);
+            } else {
+                processSegment<false>(group, frames + sample * width, chunk + sample, length);
+            }
+            advanceSegment(group, length);
+            sample += length;
+        }
+
+        for (int lane = 0; lane < width; ++lane) {
+            float* output = (group.active & (1u << lane)) ? streams[firstId + lane] : nullptr;
+            if (output != nullptr) {
+                for (int sample = 0; sample < chunk_length; ++sample) {
+                    output[chunk + sample] = frames[sample * width + lane];
+                }
+            }
+        }
+    }
+
+    for (int lane = 0; lane < width; ++lane) {
+        if (group.active & (1u << lane)) {
+            group.feedback[lane] = group.settings[lane].feedback;
+            group.wet[lane] = group.settings[lane].dry_wet;
+        }
+    }
+}
+
+int StreamBatch::getSegmentLength(const StreamGroup& group, int length, bool& crossfading) const
+{
+    // Up to the next grain start, crossfade end or glide end in any lane, so
+    // the kernel runs without per-lane events.
+    crossfading = false;
+    for (int lane = 0; lane < width; ++lane) {
+        if ((group.active & (1u << lane)) == 0) {
+            continue;
+        }
+        const int since = group.since_reset[lane];
+        length = std::min(length, group.grain_len[lane] - since);
+        if (since < smoothing_window) {
+            length = std::min(length, smoothing_window - since);
+            crossfading = true;
+        }
+        if (group.min_delay_steps_left[lane] > 0) {
+            length = std::min(length, group.min_delay_steps_left[lane]);
+        }
+    }
+    return std::max(length, 1);
+}
+
+template <bool crossfading>
+void StreamBatch::processSegment(StreamGroup& group, float* frame, int blockOffset, int length)
+{
+    alignas(64) float in[width];
+    alignas(64) float fed_back[width];
+    for (int sample = 0; sample < length; ++sample, frame += width) {
+        // The input goes in first, so a delay under a sample reads it, as in
+        // readChannel.
+        for (int lane = 0; lane < width; ++lane) {
+            in[lane] = frame[lane];
+            if (group.active & (1u << lane)) {
+                int32_t position = group.w_ptr[lane] + sample;
+                position -= position >= group.length[lane] ? group.length[lane] : 0;
+                float* write = history + group.offset[lane];
+                write[position] = in[lane];
+                if (position == 0) {
+                    write[group.length[lane]] = in[lane];
+                }
+            }
+        }
+
+        readLanes<crossfading>(group, history, in, frame, fed_back, sample, blockOffset + sample);
+
+        for (int lane = 0; lane < width; ++lane) {
+            if (group.active & (1u << lane)) {
+                int32_t position = group.w_ptr[lane] + sample;
+                position -= position >= group.length[lane] ? group.length[lane] : 0;
+                float* write = history + group.offset[lane];
+                write[position] = fed_back[lane];
+                if (position == 0) {
+                    // Reads just behind the wrap interpolate into the guard sample.
+                    write[group.length[lane]] = fed_back[lane];
+                }
+            }
+        }
+    }
+}
+
+template <bool crossfading>
+BATCH_NOINLINE void StreamBatch::readLanes(const StreamGroup& group, const float* __restrict history, const float* __restrict in,
+                            float* __restrict out, float* __restrict fed_back, int sample, int t)
+{
+    // Only reads the history, and nothing here aliases, so every lane runs
+    // in one SIMD pass.
+    for (int lane = 0; lane < width; ++lane) {
+        const int s = group.since_reset[lane] + sample;
+        const double write = group.w_ptr[lane] + sample;
+        const double min_delay = group.min_delay[lane] + sample * group.min_delay_step[lane];
+        float wet = readHistory(history, group.offset[lane], group.length[lane],
+                                write - min_delay - group.base[lane] + s * group.write_step[lane]);
+        if (crossfading) {
+            const int fade = s < smoothing_window ? s : smoothing_window;
+            const float old_wet = readHistory(history, group.offset[lane], group.length[lane],
+                                              write - min_delay - group.old_base[lane] + s * group.old_write_step[lane]);
+            wet = batch_crossfade.fade_in[fade] * wet + batch_crossfade.fade_out[fade] * old_wet;
+        }
+        const float wet_gain = group.wet[lane] + t * group.wet_inc[lane];
+        const float feedback_gain = group.feedback[lane] + t * group.feedback_inc[lane];
+        out[lane] = wet * wet_gain + in[lane] * (1 - wet_gain);
+        fed_back[lane] = in[lane] + wet * feedback_gain;
+    }
+}
+
+void StreamBatch::advanceSegment(StreamGroup& group, int length)
+{
+    for (int lane = 0; lane < width; ++lane) {
+        if ((group.active & (1u << lane)) == 0) {
+            continue;
+        }
+        group.w_ptr[lane] += length;
+        if (group.w_ptr[lane] >= group.length[lane]) {
+            group.w_ptr[lane] -= group.length[lane];
+        }
+        if (group.min_delay_steps_left[lane] > 0) {
+            group.min_delay[lane] += length * group.min_delay_step[lane];
+            group.min_delay_steps_left[lane] -= length;
+            if (group.min_delay_steps_left[lane] == 0) {
+                group.min_delay[lane] = group.min_delay_target[lane];
+                group.min_delay_step[lane] = 0;
+            }
+        }
+        group.since_reset[lane] += length;
+        if (group.since_reset[lane] >= group.grain_len[lane]) {
+            startGrain(group, lane);
+        }
+    }
+}
+
+//==============================================================================
+BatchThroughput StreamBatch::getThroughput() const
+{
+    BatchThroughput throughput;
+    throughput.stream_seconds = stream_samples / fs;
+    throughput.busy_seconds = busy_seconds;
+    throughput.lane_occupancy = lane_samples > 0 ? stream_samples / lane_samples : 0;
+    return throughput;
+}
+
+void StreamBatch::resetThroughput()
+{
+    stream_samples = 0;
+    lane_samples = 0;
+    busy_seconds = 0;
+}
@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+    StreamBatch.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../core/SplutterEngine.h"
+#include "../memory/HistoryPool.h"
+#include <stdint.h>
+#include <vector>
+
+// Streams run side by side in groups of this many lanes, one lane per stream.
+// 8 fills two AVX2 registers of doubles for the read positions; 16 suits
+// AVX-512.
+#ifndef SPLUTTER_BATCH_WIDTH
+ #define SPLUTTER_BATCH_WIDTH 8
+#endif
+
+// What one stream sounds like. The same units and ranges as the plugin.
+struct StreamSettings {
+    float feedback;    // 0 to 0.95
+    float dry_wet;     // 0 to 1
+    float pitch_shift; // semitones
+    float rate;        // grain length, seconds
+    float min_delay;   // seconds
+
+    StreamSettings(): feedback(0.0f), dry_wet(0.5f), pitch_shift(0.0f), rate(1.0f), min_delay(1.0f) {}
+};
+
+// The furthest a stream's settings will go, which sets the size of its delay
+// history. The defaults are the plugin's full ranges, which need seconds of
+// history; short voice streams with tight limits need a small fraction of it.
+// Settings outside the limits are clamped to them.
+struct StreamLimits {
+    float pitch_range;   // semitones either way
+    float longest_grain; // seconds
+    float longest_delay; // seconds of min delay
+
+    StreamLimits(): pitch_range(max_pitch_shift), longest_grain(max_lfo_rate), longest_delay(max_delay_slider_val) {}
+};
+
+struct BatchThroughput {
+    double stream_seconds; // audio processed, summed over the streams
+    double busy_seconds;   // time spent in process
+    double lane_occupancy; // fraction of the lanes processed that held a stream
+
+    // How many streams one core keeps up with in real time.
+    double getStreamsPerCore() const { return busy_seconds > 0 ? stream_seconds / busy_seconds : 0; }
+};
+
+// Many independent mono streams through the sawtooth engine at once, for
+// servers that run one short voice stream per client.
+//
+// A SplutterEngine per stream would carry two channels, the EQ, the
+// vocoders and the program fades for every stream, and jump between objects
+// for every block. Here the streams' state is kept as arrays across the
+// lanes of a group, and each sample runs all the lanes of a group in one
+// loop, which the compiler turns into SIMD, gathers and all. What runs is
+// the sawtooth engine with its grain crossfade, the min delay glide, the
+// feedback and the mix; the EQ, stereo routing, saturation and the other
+// engines are left out.
+//
+// Every stream's delay history comes from one slab, taken from the
+// HistoryPool when the batch is made and sized for the streams' limits, so
+// adding a stream never allocates. A removed stream's history is cleared a
+// little at a time over the following process calls before it is reused.
+// Adding, removing and setting streams doesn't allocate, lock or clear
+// anything big; call them on the processing thread, between process calls.
+class StreamBatch
+{
+public:
+    static constexpr int width = SPLUTTER_BATCH_WIDTH;
+    static_assert(width == 8 || width == 16, "batches are 8 or 16 lanes");
+
+    // Allocates, so keep it off the processing thread, like the destructor.
+    StreamBatch(double sampleRate, int maxStreams, size_t slabBytes);
+    ~StreamBatch();
+
+    // False if the slab couldn't be allocated.
+    bool isAllocated() const { return slab.data != nullptr; }
+
+    // Returns the new stream's id, from 0 to getCapacity() - 1, or -1 if
+    // every slot is taken or the slab has no room for the limits' history.
+    // The lowest free id is used, so the groups stay full.
+    int addStream(const StreamSettings& settings, const StreamLimits& limits = StreamLimits());
+    void removeStream(int id);
+    // The mix and feedback ramp over the next block and the min delay
+    // glides over half a second, as in the plugin. A new pitch or grain
+    // length starts with the stream's next grain.
+    void setStream(int id, const StreamSettings& settings);
+
+    int getNumStreams() const { return num_streams; }
+    int getCapacity() const { return (int) groups.size() * width; }
+
+    // streams[id] is stream id's buffer of numSamples, processed in place.
+    // Null buffers, and entries for ids with no stream, are skipped.
+    void process(float* const* streams, int numSamples);
+
+    BatchThroughput getThroughput() const;
+    void resetThroughput();
+
+private:
+    // One group of lanes. Ramps start from the values at the start of the
+    // block; the grain and glide state move on with each segment.
+    struct StreamGroup {
+        uint32_t active; // a bit per lane with a stream
+
+        alignas(64) int32_t offset[width];      // history start in the slab
+        alignas(64) int32_t length[width];      // history length, without the guard sample
+        alignas(64) int32_t w_ptr[width];
+        alignas(64) int32_t since_reset[width];
+        alignas(64) int32_t grain_len[width];
+        alignas(64) int32_t min_delay_steps_left[width];
+        // Delay in samples is min_delay + base - s * write_step, s samples
+        // into the grain, and the same for the grain fading out.
+        alignas(64) double write_step[width];
+        alignas(64) double base[width];
+        alignas(64) double old_write_step[width];
+        alignas(64) double old_base[width];
+        alignas(64) double min_delay[width];
+        alignas(64) double min_delay_step[width];
+        alignas(64) double min_delay_target[width];
+        alignas(64) float feedback[width];
+        alignas(64) float feedback_inc[width];
+        alignas(64) float wet[width];
+        alignas(64) float wet_inc[width];
+
+        StreamSettings settings[width];
+        StreamLimits limits[width];
+    };
+
+    struct SlabRange {
+        int32_t offset;
+        int32_t size;
+    };
+
+    // Blocks are processed this many frames at a time, through frames.
+    static constexpr int max_chunk = 128;
+    // Lanes without a stream read an untouched stretch at the start of the slab.
+    static constexpr int idle_length = max_chunk + 16;
+    // Samples of a removed stream's history cleared per process call.
+    static constexpr int clear_budget = 1 << 16;
+
+    double fs;
+    float samps_for_delay_move;
+    HistoryBlock slab;
+    float* history;
+    std::vector<StreamGroup> groups;
+    int num_streams;
+    int groups_in_use; // groups past this one are empty
+
+    // Clean free space, sorted by offset, and removed histories still to be
+    // cleared. Reserved up front, so they never grow.
+    std::vector<SlabRange> free_ranges;
+    std::vector<SlabRange> dirty_ranges;
+    int dirty_cleared;
+
+    alignas(64) float frames[max_chunk * width];
+
+    double stream_samples;
+    double lane_samples;
+    double busy_seconds;
+
+    int getHistorySize(const StreamLimits& limits) const;
+    int takeRange(int size);
+    void giveRange(SlabRange range);
+    void clearDirtyRanges();
+
+    void setIdle(StreamGroup& group, int lane);
+    StreamSettings clampSettings(const StreamSettings& settings, const StreamLimits& limits) const;
+    void setMinDelayTarget(StreamGroup& group, int lane, bool glide);
+    void startGrain(StreamGroup& group, int lane);
+
+    void processGroup(StreamGroup& group, float* const* streams, int firstId, int numSamples);
+    int getSegmentLength(const StreamGroup& group, int length, bool& crossfading) const;
+    template <bool crossfading>
+    void processSegment(StreamGroup& group, float* frame, int blockOffset, int length);
+    template <bool crossfading>
+    static void readLanes(const StreamGroup& group, const float* __restrict history, const float* __restrict in,
+                          float* __restrict out, float* __restrict fed_back, int sample, int t);
+    void advanceSegment(StreamGroup& group, int length);
+
+    StreamBatch(const StreamBatch&) = delete;
+    StreamBatch& operator=(const StreamBatch&) = delete;
+};
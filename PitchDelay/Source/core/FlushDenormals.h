@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    FlushDenormals.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#if defined (__SSE__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP > 0)
+ #include <xmmintrin.h>
+ #define SPLUTTER_FLUSH_SSE 1
+#elif defined (__aarch64__)
+ #define SPLUTTER_FLUSH_ARM64 1
+#endif
+
+// Flushes denormals to zero until the end of the scope, like JUCE's
+// ScopedNoDenormals, so feedback tails decaying towards zero don't slow
+// the kernels down. Does nothing on other processors.
+class ScopedFlushDenormals
+{
+public:
+    ScopedFlushDenormals() {
+#if SPLUTTER_FLUSH_SSE
+        previous = _mm_getcsr();
+        _mm_setcsr(previous | 0x8040); // flush to zero, denormals are zero
+#elif SPLUTTER_FLUSH_ARM64
+        asm volatile ("mrs %0, fpcr" : "=r" (previous));
+        asm volatile ("msr fpcr, %0" : : "r" (previous | (1 << 24)));
+#endif
+    }
+    ~ScopedFlushDenormals() {
+#if SPLUTTER_FLUSH_SSE
+        _mm_setcsr(previous);
+#elif SPLUTTER_FLUSH_ARM64
+        asm volatile ("msr fpcr, %0" : : "r" (previous));
+#endif
+    }
+
+private:
+#if SPLUTTER_FLUSH_ARM64
+    unsigned long previous;
+#else
+    unsigned int previous;
+#endif
+    
+    ScopedFlushDenormals(const ScopedFlushDenormals&) = delete;
+    ScopedFlushDenormals& operator=(const ScopedFlushDenormals&) = delete;
+};
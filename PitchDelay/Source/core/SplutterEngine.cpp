@@ -0,0 +1,1703 @@
+/*
+  ==============================================================================
+
+    SplutterEngine.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "SplutterEngine.h"
+#include "FlushDenormals.h"
+
+// Equal-power gains for the sawtooth crossfade, indexed by s.
+struct CrossfadeTable {
+    float fade_in[smoothing_window];
+    float fade_out[smoothing_window];
+    
+    CrossfadeTable() {
+        for (int s = 0; s < smoothing_window; ++s) {
+            fade_in[s] = sin( PI *(((float)s) / (float)smoothing_window) / 2.0);
+            fade_out[s] = cos( PI *(((float)s) / (float)smoothing_window) / 2);
+        }
+    }
+};
+static const CrossfadeTable crossfade_table;
+
+// Hann window over one overlap-add grain, with a guard point so the lookup
+// can interpolate past the last entry.
+struct GrainWindowTable {
+    float gain[window_table_size + 1];
+    
+    GrainWindowTable() {
+        for (int i = 0; i <= window_table_size; ++i) {
+            gain[i] = 0.5 - 0.5 * cos(2 * PI * i / (float)window_table_size);
+        }
+    }
+};
+static const GrainWindowTable grain_window;
+
+// The trajectory engine's built-in shapes, indexed by TrajectoryShape.
+struct BuiltInTrajectories {
+    TrajectoryTable shapes[NUM_BUILT_IN_SHAPES];
+    
+    BuiltInTrajectories() {
+        shapes[shape_sawtooth].setSawtooth();
+        shapes[shape_triangle].setTriangle();
+        shapes[shape_stepped].setStepped();
+        shapes[shape_random_walk].setRandomWalk();
+    }
+};
+static const BuiltInTrajectories built_in_trajectories;
+
+// Shapes of the feedback EQ bands.
+static const int eq_band_types[NUM_EQ_BANDS] = {
+    FilterCalc::bandLowShelf, FilterCalc::bandPeak, FilterCalc::bandPeak, FilterCalc::bandHighShelf
+};
+
+#if SPLUTTER_PROFILE
+// Regime names for the kernel zones, indexed like the enums.
+static const char* const pitch_regime_names[] = {
+    "pitch_unity", "pitch_up", "pitch_down", "pitch_mixed", "pitch_overlap", "pitch_spectral", "pitch_trajectory"
+};
+static const char* const feedback_regime_names[] = {
+    "feedback_off", "feedback_on", "feedback_cross", "feedback_saturated", "feedback_cross_saturated"
+};
+static const char* const filter_regime_names[] = {
+    "filters_flat", "filters_pre", "filters_feedback", "filters_post", "filters_crossfade"
+};
+static const char* const mix_regime_names[] = { "mix_dry", "mix_wet", "mix_blend" };
+#endif
+
+// Note values for the tempo synced rate and delay, in quarter notes.
+static const double note_value_beats[NUM_NOTE_VALUES] = {
+    0.0, 0.25, 1.0 / 3.0, 0.375, 0.5, 2.0 / 3.0, 0.75, 1.0, 4.0 / 3.0, 1.5, 2.0, 4.0, 8.0
+};
+
+EngineParameters::EngineParameters()
+{
+    feedback = 0.0f;
+    dry_wet = 0.5f;
+    pitch_shift = 0.0f;
+    rate = 1.0f;
+    min_delay = 1.0f;
+    lo_cut = 10.0f;
+    hi_cut = 20000.0f;
+    for (int band = 0; band < NUM_EQ_BANDS; ++band) {
+        eq_freq[band] = eq_default_freqs[band];
+        eq_gain[band] = 0.0f;
+        eq_q[band] = 0.7f;
+    }
+    eq_placement = eq_in_feedback;
+    rate_sync = 0;
+    delay_sync = 0;
+    engine = engine_sawtooth;
+    overlap = 2;
+    shape = shape_sawtooth;
+    stereo_feedback = stereo_normal;
+    feedback_width = 1.0f;
+    saturation = 0;
+    drive = 0.0f;
+    delay_change = delay_glide;
+    glide_time = 0.5f;
+    glide_curve = glide_linear;
+    key_mode = key_off;
+    root_note = 60;
+}
+
+//==============================================================================
+SplutterEngine::SplutterEngine()
+{
+    // Until something is drawn, the drawn shape is a plain sawtooth.
+    drawn_points[0] = 0.0f;
+    drawn_points[1] = 1.0f;
+    num_drawn_points = 2;
+    drawn_table = 0;
+    drawn_tables[0].setFromPoints(drawn_points, num_drawn_points);
+    drawn_tables[1] = drawn_tables[0];
+    initialiseState();
+}
+
+void SplutterEngine::initialiseState()
+{
+    // Zeroed, with fresh filters and saturators, then set up as below.
+    static_cast<EngineState&>(*this) = EngineState();
+    for (int i = 0; i < NUM_PARAMETERS; ++i) {
+        ramps[i] = ParameterRamp();
+    }
+    fs = 44100;
+    buffer_write_pos = 0;
+    delay_samples = 0;
+    buffer_length = 0;
+    latency_samples = 0;
+    samps_for_delay_move = fs * parameters.glide_time;
+    delay_jump_pending = false;
+    delay_jump_target = 0;
+    
+    eq_placement = eq_in_feedback;
+    eq_placement_from = eq_in_feedback;
+    placement_fade_pos = placement_fade_len;
+    pitch_regime = pitch_unity;
+    feedback_regime = feedback_off;
+    saturation = 0;
+    filter_regime = filters_feedback;
+    mix_regime = mix_blend;
+    
+    samples_since_reset = 0;
+    grain_carry = 0;
+    num_grain_boundaries = 0;
+    next_grain_boundary = 0;
+    host_bpm = 120;
+    block_ppq = 0;
+    transport_playing = false;
+    num_key_events = 0;
+    num_held_keys = 0;
+    key_note = -1;
+    key_shape_waiting = false;
+    key_crossfade_pending = false;
+    grains_locked = false;
+    min_delay_actual = 0;
+    min_delay_step = 0;
+    min_delay_steps_left = 0;
+    min_delay_target = 0;
+    glide_from = 0;
+    glide_len = 0;
+    glide_pos = 0;
+    glide_curve = glide_linear;
+    
+    head_phase = 0;
+    overlap_heads = 0;
+    vocoders = vocoder_banks[0];
+    dry_delay = dry_delay_banks[0];
+    dry_delay_pos = 0;
+    active_engine = -1;
+    grain_note_value = 0;
+    trajectory = getTrajectory(shape_sawtooth);
+    old_trajectory = trajectory;
+    feedback_matrix.setIdentity();
+    prev_feedback_matrix.setIdentity();
+    for (int head = 0; head < max_heads; ++head) {
+        head_spacing[head] = 0;
+        head_offset[head] = 0;
+        head_slope[head] = 0;
+    }
+    
+    for (int bank = 0; bank < 2; ++bank) {
+        for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+            vocoder_banks[bank][channel].reset();
+            std::fill(dry_delay_banks[bank][channel], dry_delay_banks[bank][channel] + PhaseVocoder::latency, 0.0);
+        }
+    }
+    
+    program_switch_pending = false;
+    hold_parameters = false;
+    fading_engine = *this;
+    fading_feedback = 0;
+    fading_wet = 0;
+    program_fade_pos = program_fade_len;
+    
+    bypassed = false;
+    bypass_fade_pos = 0;
+}
+
+bool SplutterEngine::resizeBuffer()
+{
+    buffer_length = (int)(semitones_to_ratio(max_pitch_shift) * (fs * max_lfo_rate + smoothing_window) + max_delay_slider_val * fs);
+    // The pool hands back a zeroed block, so there is no need to clear it here.
+    return delay_buffer.allocate(NUM_CHANNELS, buffer_length);
+}
+
+bool SplutterEngine::prepare(double sampleRate)
+{
+    fs = sampleRate;
+    for (int placement = 0; placement < NUM_EQ_PLACEMENTS; ++placement) {
+        for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+            FilterChain& chain = filter_chains[placement][channel];
+            chain.lo_cut.setSampleRate(fs);
+            chain.hi_cut.setSampleRate(fs);
+            chain.clear();
+        }
+    }
+    samps_for_delay_move = fs * parameters.glide_time;
+    min_delay->a_param = std::min(getSyncedSeconds(parameters.delay_sync, parameters.min_delay), max_delay_slider_val) * fs;
+    min_delay_actual = toFixed(min_delay->a_param);
+    min_delay_target = min_delay_actual;
+    min_delay_steps_left = 0;
+    glide_pos = glide_len;
+    delay_jump_pending = false;
+    active_engine = -1; // start the vocoder from silence
+    program_fade_pos = program_fade_len;
+    
+    calculateParameters();
+
+    
+    old_max_delay = max_delay;
+    old_write_step = write_step;
+    old_lfo_len = lfo_len;
+    old_trajectory = trajectory;
+    prev_feedback_matrix = feedback_matrix;
+    const bool allocated = resizeBuffer();
+    
+    
+    
+    delay_samples = lfo_rate->a_param;
+    buffer_write_pos = delay_samples;
+    samples_since_reset = 0;
+    grain_carry = 0;
+    head_phase = 0;
+    for (int head = 0; head < max_heads; ++head) {
+        latchHead(head);
+    }
+    
+    // Touch everything a program switch uses now, so the first switch
+    // doesn't fault it in on the audio thread.
+    fading_engine = *this;
+    for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+        std::fill(fade_output_float[channel], fade_output_float[channel] + program_fade_len, 0.0f);
+        std::fill(fade_output_double[channel], fade_output_double[channel] + program_fade_len, 0.0);
+        std::fill(fade_history[channel], fade_history[channel] + program_fade_len, 0.0f);
+        vocoder_banks[1][channel].reset();
+        std::fill(dry_delay_banks[1][channel], dry_delay_banks[1][channel] + PhaseVocoder::latency, 0.0);
+    }
+    return allocated;
+}
+
+void SplutterEngine::release()
+{
+    // Give the delay history back to the shared pool, so that bypassed or
+    // inactive instances don't hold on to their worst-case buffer.
+    delay_buffer.release();
+}
+
+bool SplutterEngine::reset(double sampleRate)
+{
+    parameters = EngineParameters();
+    initialiseState();
+    return prepare(sampleRate);
+}
+
+void SplutterEngine::setTransport(double bpm, double ppq, bool playing)
+{
+    // Without a playing transport, synced values still follow the last tempo
+    // we saw, but the grains run free.
+    if (bpm > 0) {
+        host_bpm = bpm;
+    }
+    block_ppq = ppq;
+    transport_playing = playing;
+}
+
+void SplutterEngine::switchProgram()
+{
+    program_switch_pending = true;
+}
+
+void SplutterEngine::holdParameters(bool hold)
+{
+    hold_parameters = hold;
+}
+
+void SplutterEngine::addKeyEvent(int sampleOffset, int note, bool down)
+{
+    if (num_key_events < max_key_events) {
+        key_events[num_key_events++] = { std::max(sampleOffset, 0), note, down };
+    }
+}
+
+void SplutterEngine::takeKeyEvent(const KeyEvent& event)
+{
+    if (event.note == all_keys) {
+        num_held_keys = 0;
+        return;
+    }
+    int kept = 0;
+    for (int i = 0; i < num_held_keys; ++i) {
+        if (held_keys[i] != event.note) {
+            held_keys[kept++] = held_keys[i];
+        }
+    }
+    num_held_keys = kept;
+    if (event.down) {
+        if (num_held_keys == max_held_keys) {
+            // The oldest key drops out.
+            std::copy(held_keys + 1, held_keys + max_held_keys, held_keys);
+            --num_held_keys;
+        }
+        held_keys[num_held_keys++] = event.note;
+    }
+    
+    // Letting go of the last key held goes back to the one held before it.
+    if (num_held_keys == 0 || held_keys[num_held_keys - 1] == key_note) {
+        return;
+    }
+    key_note = held_keys[num_held_keys - 1];
+    if (parameters.key_mode == key_immediate) {
+        key_crossfade_pending = true;
+    } else if (parameters.key_mode == key_next_grain) {
+        key_shape_waiting = true;
+    }
+}
+
+float SplutterEngine::semitones_to_ratio(float interval)
+{
+    return pow(2.0, interval / 12.0);
+}
+
+float SplutterEngine::getSyncedSeconds(int note_value, float free_seconds) const
+{
+    if (note_value <= 0 || note_value >= NUM_NOTE_VALUES) {
+        return free_seconds;
+    }
+    return note_value_beats[note_value] * 60.0 / host_bpm;
+}
+
+void SplutterEngine::calculateParameters()
+{
+    feedback_level->a_param = parameters.feedback;
+    dry_wet->a_param = parameters.dry_wet;
+        
+    // lfo rate a param: number of samples per saw
+    // A synced grain that doesn't fit the rate range is clamped, and then it
+    // can't follow the beat, so it runs free.
+    float lfo_seconds = getSyncedSeconds(parameters.rate_sync, parameters.rate);
+    float clamped_lfo_seconds = std::min(std::max(lfo_seconds, min_lfo_rate), max_lfo_rate);
+    grain_note_value = parameters.rate_sync;
+    grains_locked = grain_note_value > 0 && transport_playing && lfo_seconds == clamped_lfo_seconds;
+    lfo_rate->a_param = clamped_lfo_seconds * fs;
+    
+    // how much will the read pointer move per sample?
+    float semitones = parameters.pitch_shift;
+    if (parameters.key_mode != key_off && key_note >= 0) {
+        semitones = std::min(std::max((float) (key_note - parameters.root_note), -max_pitch_shift), max_pitch_shift);
+    }
+    pitch_shift->a_param = semitones_to_ratio(semitones);
+
+    float delay_seconds = getSyncedSeconds(parameters.delay_sync, parameters.min_delay);
+    min_delay->a_param = std::min(delay_seconds, max_delay_slider_val) * fs;
+    // The move is only planned when the target changes, so it takes the same
+    // path whatever the block size. A jump is left for processSamples to
+    // start, since it needs the fade to itself.
+    samps_for_delay_move = fs * std::min(std::max(parameters.glide_time, min_glide_time), max_glide_time);
+    const FixedPosition new_target = toFixed(min_delay->a_param);
+    if (parameters.delay_change == delay_jump) {
+        delay_jump_pending = new_target != min_delay_target;
+        delay_jump_target = new_target;
+    } else if (new_target != min_delay_target) {
+        delay_jump_pending = false;
+        min_delay_target = new_target;
+        glide_curve = parameters.glide_curve;
+        if (glide_curve == glide_linear) {
+            // One straight piece the whole way.
+            FixedPosition distance = min_delay_target - min_delay_actual;
+            min_delay_step = distance / (FixedPosition) samps_for_delay_move;
+            if (min_delay_step != 0) {
+                min_delay_steps_left = (int) (distance / min_delay_step);
+            } else {
+                min_delay_steps_left = 0;
+            }
+            glide_pos = glide_len;
+        } else {
+            glide_from = min_delay_actual;
+            glide_len = std::max((int) samps_for_delay_move, 1);
+            glide_pos = 0;
+            planGlidePiece();
+        }
+    }
+    
+    takeDrawnTrajectory();
+    
+    // We don't want to change the shape of the sawtooth while we are in the
+    // middle of transitioning, that will cause clicking.
+    if (samples_since_reset > smoothing_window || samples_since_reset == 0) {
+        updateGrainShape();
+    }
+    for (int i = 0; i < NUM_PARAMETERS; ++i) {
+        ramps[i].curr_val = ramps[i].a_param;
+    }
+    
+    float Q = 1.0;
+    for (int placement = 0; placement < NUM_EQ_PLACEMENTS; ++placement) {
+        for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+            filter_chains[placement][channel].lo_cut.setHighPass(parameters.lo_cut, Q);
+            filter_chains[placement][channel].hi_cut.setLowPass(parameters.hi_cut, Q);
+        }
+    }
+    
+    if (parameters.overlap != overlap_heads) {
+        setOverlapHeads(parameters.overlap);
+    }
+    updateEngine();
+    feedback_matrix = getStereoFeedbackMatrix(parameters.stereo_feedback, parameters.feedback_width);
+    saturation = parameters.saturation;
+    for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+        if (saturation > 0) {
+            saturators[channel].setOrder(saturation);
+        }
+        saturators[channel].setDrive(pow(10.0f, parameters.drive / 20.0f));
+    }
+    
+    calculateEqCoefficients();
+    updateEqPlacement();
+    selectRegimes();
+}
+
+void SplutterEngine::updateGrainShape()
+{
+    // The next grain's shape. The one playing keeps the old_ values.
+    trajectory = getTrajectory(parameters.shape);
+    lfo_len = lfo_rate->a_param;
+    write_step = pitch_shift->a_param - 1;
+    // max delay: maximum number of samples between read pointer and write pointer
+    if (pitch_shift->a_param == 1) {
+        // no pitch up or down.
+        max_delay = lfo_rate->a_param;
+    } else {
+        max_delay = abs(pitch_shift->a_param - 1) * lfo_rate->a_param;
+    }
+    key_shape_waiting = false;
+}
+
+void SplutterEngine::latchHead(int head)
+{
+    // Same shape as the sawtooth: the delay shrinks over the grain when
+    // pitching up and grows when pitching down.
+    if (write_step > 0) {
+        head_offset[head] = max_delay;
+        head_slope[head] = -max_delay;
+    } else if (write_step < 0) {
+        head_offset[head] = 0;
+        head_slope[head] = max_delay;
+    } else {
+        head_offset[head] = 0;
+        head_slope[head] = 0;
+    }
+}
+
+void SplutterEngine::updateEngine()
+{
+    if (parameters.engine != active_engine) {
+        active_engine = parameters.engine;
+        // The vocoder starts from silence rather than from whatever it held
+        // the last time it was used.
+        if (active_engine == engine_spectral) {
+            for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+                vocoders[channel].reset();
+                std::fill(dry_delay[channel], dry_delay[channel] + PhaseVocoder::latency, 0.0);
+            }
+            dry_delay_pos = 0;
+        }
+        latency_samples = active_engine == engine_spectral ? PhaseVocoder::latency : 0;
+    }
+    for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+        vocoders[channel].setPitchRatio(pitch_shift->a_param);
+    }
+}
+
+void SplutterEngine::setOverlapHeads(int heads)
+{
+    // Changing the overlap moves the heads, so they all take the current
+    // shape. Spare heads sit on the first one and are never read.
+    overlap_heads = std::min(std::max(heads, 1), max_heads);
+    for (int head = 0; head < max_heads; ++head) {
+        head_spacing[head] = head < overlap_heads ? head / (float)overlap_heads : 0;
+        latchHead(head);
+    }
+}
+
+static int getFeedbackRegime(bool feeding_back, bool crossing, bool saturating)
+{
+    if (! feeding_back) {
+        return feedback_off;
+    } else if (crossing) {
+        return saturating ? feedback_cross_saturated : feedback_cross;
+    } else {
+        return saturating ? feedback_saturated : feedback_on;
+    }
+}
+
+void SplutterEngine::planGlidePiece()
+{
+    // Each piece ends where the curve is at its end, so the rounding in the
+    // steps doesn't build up over the glide.
+    const int length = std::min(glide_piece_len, glide_len - glide_pos);
+    glide_pos += length;
+    FixedPosition end = min_delay_target;
+    if (glide_pos < glide_len) {
+        double x = glide_pos / (double) glide_len;
+        double shape;
+        if (glide_curve == glide_ease) {
+            shape = x * x * (3 - 2 * x);
+        } else {
+            // Fast at first and settling in, like a motor catching up.
+            shape = (1 - exp(-5 * x)) / (1 - exp(-5.0));
+        }
+        end = glide_from + (FixedPosition) ((min_delay_target - glide_from) * shape);
+    }
+    min_delay_step = (end - min_delay_actual) / length;
+    min_delay_steps_left = length;
+}
+
+void SplutterEngine::beginFade()
+{
+    // The outgoing engine keeps going as it is, with its gains held where
+    // they were, and the spectral engine's vocoders and dry delay.
+    fading_engine = *this;
+    fading_feedback = feedback_level->curr_val;
+    fading_wet = dry_wet->curr_val;
+    fading_engine.prev_feedback_matrix = fading_engine.feedback_matrix;
+    fading_engine.feedback_regime = getFeedbackRegime(fading_feedback != 0, ! fading_engine.feedback_matrix.isIdentity(),
+                                                      fading_engine.saturation > 0);
+    fading_engine.mix_regime = fading_wet == 0 ? mix_dry : (fading_wet == 1 ? mix_wet : mix_blend);
+    
+    // The live program takes the other bank. If it stays spectral, it picks up
+    // where the old vocoders are rather than starting from silence.
+    const int bank = vocoders == vocoder_banks[0] ? 1 : 0;
+    vocoders = vocoder_banks[bank];
+    dry_delay = dry_delay_banks[bank];
+    if (active_engine == engine_spectral && parameters.engine == engine_spectral) {
+        for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+            vocoders[channel].copyFrom(fading_engine.vocoders[channel]);
+            std::copy(fading_engine.dry_delay[channel], fading_engine.dry_delay[channel] + PhaseVocoder::latency,
+                      dry_delay[channel]);
+        }
+    }
+}
+
+void SplutterEngine::beginProgramSwitch()
+{
+    beginFade();
+    
+    // A fresh grain, so the new shape is taken up at once.
+    samples_since_reset = 0;
+    calculateParameters();
+    restartEngine();
+    program_fade_pos = 0;
+}
+
+void SplutterEngine::beginDelayJump()
+{
+    // The outgoing engine carries on reading at the old delay while the live
+    // one reads at the new, and the program fade crosses between them. The
+    // grain and the parameter ramps go on as they were.
+    beginFade();
+    delay_jump_pending = false;
+    min_delay_target = delay_jump_target;
+    min_delay_actual = min_delay_target;
+    min_delay_steps_left = 0;
+    glide_pos = glide_len;
+    program_fade_pos = 0;
+}
+
+void SplutterEngine::beginKeyCrossfade()
+{
+    // The outgoing engine plays on at the old interval while the live one
+    // starts a fresh grain at the new, and the program fade crosses between
+    // them. The delay, the ramps and the filters go on as they were.
+    beginFade();
+    key_crossfade_pending = false;
+    samples_since_reset = 0;
+    grain_carry = 0;
+    updateGrainShape();
+    old_lfo_len = lfo_len;
+    old_max_delay = max_delay;
+    old_write_step = write_step;
+    old_trajectory = trajectory;
+    head_phase = 0;
+    for (int head = 0; head < max_heads; ++head) {
+        latchHead(head);
+    }
+    pitch_regime = getPitchRegime();
+    program_fade_pos = 0;
+}
+
+void SplutterEngine::restartEngine()
+{
+    // The fade covers the jump to the new program, so the live engine goes
+    // straight there instead of smoothing its own way across: no crossfade
+    // from the old sawtooth, no delay glide, no parameter ramps and no EQ
+    // placement fade.
+    grain_carry = 0;
+    old_lfo_len = lfo_len;
+    old_max_delay = max_delay;
+    old_write_step = write_step;
+    old_trajectory = trajectory;
+    if (delay_jump_pending) {
+        min_delay_target = delay_jump_target;
+        delay_jump_pending = false;
+    }
+    key_crossfade_pending = false;
+    min_delay_actual = min_delay_target;
+    min_delay_steps_left = 0;
+    glide_pos = glide_len;
+    head_phase = 0;
+    for (int head = 0; head < max_heads; ++head) {
+        latchHead(head);
+    }
+    for (int i = 0; i < NUM_PARAMETERS; ++i) {
+        ramps[i].prev_val = ramps[i].curr_val;
+    }
+    prev_feedback_matrix = feedback_matrix;
+    eq_placement_from = eq_placement;
+    placement_fade_pos = placement_fade_len;
+    for (int placement = 0; placement < NUM_EQ_PLACEMENTS; ++placement) {
+        for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+            filter_chains[placement][channel].clear();
+        }
+    }
+    selectRegimes();
+}
+
+void SplutterEngine::updateEqPlacement()
+{
+    // A new placement is only picked up once the previous fade has finished.
+    int requested = parameters.eq_placement;
+    if (placement_fade_pos >= placement_fade_len && requested != eq_placement) {
+        eq_placement_from = eq_placement;
+        eq_placement = requested;
+        placement_fade_pos = 0;
+        for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+            filter_chains[eq_placement][channel].clear();
+        }
+    }
+}
+
+int SplutterEngine::getPitchRegime() const
+{
+    if (active_engine == engine_overlap) {
+        return pitch_overlap;
+    } else if (active_engine == engine_spectral) {
+        return pitch_spectral;
+    } else if (write_step == 0 && old_write_step == 0) {
+        // The trajectory engine's heads both sit at the min delay here, and
+        // crossfading one sample with itself would boost it in the loop.
+        return pitch_unity;
+    } else if (active_engine == engine_trajectory) {
+        return pitch_trajectory;
+    } else if (write_step > 0 && old_write_step > 0) {
+        return pitch_up;
+    } else if (write_step < 0 && old_write_step < 0) {
+        return pitch_down;
+    } else {
+        return pitch_mixed;
+    }
+}
+
+void SplutterEngine::selectRegimes()
+{
+    pitch_regime = getPitchRegime();
+    
+    // Feedback and mix ramp from last block's value to this block's.
+    const int feedback = getFeedbackRegime(feedback_level->prev_val != 0 || feedback_level->curr_val != 0,
+                                           ! prev_feedback_matrix.isIdentity() || ! feedback_matrix.isIdentity(),
+                                           saturation > 0);
+    // The saturators only hear the loop while they are in it, so they start
+    // again from silence rather than from whatever they heard last.
+    if (saturates(feedback) && ! saturates(feedback_regime)) {
+        for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+            saturators[channel].reset();
+        }
+    }
+    feedback_regime = feedback;
+    
+    if (dry_wet->prev_val == 0 && dry_wet->curr_val == 0) {
+        mix_regime = mix_dry;
+    } else if (dry_wet->prev_val == 1 && dry_wet->curr_val == 1) {
+        mix_regime = mix_wet;
+    } else {
+        mix_regime = mix_blend;
+    }
+    
+    bool flat = parameters.lo_cut <= 10.0 && parameters.hi_cut >= 20000.0
+        && filter_chains[eq_placement][0].eq.isFlat();
+    if (placement_fade_pos < placement_fade_len) {
+        filter_regime = filters_crossfade;
+    } else if (flat) {
+        filter_regime = filters_flat;
+    } else {
+        filter_regime = filters_pre + eq_placement;
+    }
+}
+
+void SplutterEngine::calculateEqCoefficients()
+{
+    float fc[NUM_EQ_BANDS], gain[NUM_EQ_BANDS], Q[NUM_EQ_BANDS];
+    for (int band = 0; band < NUM_EQ_BANDS; ++band) {
+        fc[band] = parameters.eq_freq[band];
+        gain[band] = parameters.eq_gain[band];
+        Q[band] = parameters.eq_q[band];
+    }
+    
+    // Both channels share the EQ settings, so one batch covers every band.
+    float coeffs[5 * NUM_EQ_BANDS];
+    FilterCalc::calcCoeffsBands(coeffs, eq_band_types, fc, gain, Q, NUM_EQ_BANDS, fs);
+    for (int placement = 0; placement < NUM_EQ_PLACEMENTS; ++placement) {
+        for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+            filter_chains[placement][channel].eq.setCoefficients(coeffs, NUM_EQ_BANDS);
+        }
+    }
+}
+
+float SplutterEngine::getInBetween(const float* buffer, FixedPosition position)
+{
+    // Currently linear interpolation, maybe i should do more.
+    int lower_index = (int) (position >> fixed_shift);
+    float offset = (position & fixed_fraction_mask) * (1.0f / fixed_one);
+    return buffer[lower_index] * (1 - offset) + (offset) * buffer[lower_index + 1];
+}
+
+
+float SplutterEngine::linInterpolation(const float start, const float end, const float fract)
+{
+    return start + (fract * (end - start));
+}
+
+template <int pitch>
+FixedPosition SplutterEngine::getRPointer(int s, FixedPosition w_ptr, FixedPosition step, FixedPosition max,
+                                                   bool is_secondary, FixedPosition min_delay)
+{
+    FixedPosition secondary_shift;
+    if (is_secondary) {
+        secondary_shift = max;
+    } else {
+        secondary_shift = 0;
+    }
+    FixedPosition r_ptr;
+    if (pitch == pitch_down) {
+        r_ptr = w_ptr + s * step - secondary_shift - min_delay;
+    } else if (pitch == pitch_up) {
+        // we need to buffer the read pointer away from the write pointer by the smoothing window,
+        // so that the secondary read pointer in the smoothing window doesn't go past the write pointer
+        r_ptr = w_ptr - max + s * step - smoothing_window * fixed_one + secondary_shift - min_delay;
+    } else if (pitch == pitch_unity) {
+        r_ptr = w_ptr - min_delay; // No secondary shift for constant delay.
+    } else if (step < 0) {
+        r_ptr = getRPointer<pitch_down>(s, w_ptr, step, max, is_secondary, min_delay);
+    } else if (step > 0) {
+        r_ptr = getRPointer<pitch_up>(s, w_ptr, step, max, is_secondary, min_delay);
+    } else {
+        r_ptr = getRPointer<pitch_unity>(s, w_ptr, step, max, is_secondary, min_delay);
+    }
+    // Wrap into the buffer without a branch.
+    return r_ptr + (r_ptr < 0) * ((FixedPosition) buffer_length << fixed_shift);
+}
+
+template <int pitch, bool crossfading>
+float SplutterEngine::getWetSaw(const Segment& segment, int sample, const float* delay_channel)
+{
+    const int s = segment.s + sample;
+    const FixedPosition w_ptr = (FixedPosition) (segment.w_ptr + sample) << fixed_shift;
+    const FixedPosition min_delay = segment.min_delay + sample * segment.min_delay_inc;
+    if (! crossfading) {
+        FixedPosition r_ptr = getRPointer<pitch>(s, w_ptr, segment.old_write_step, segment.old_max_delay, false, min_delay);
+        return getInBetween(delay_channel, r_ptr);
+    } else {
+        FixedPosition r_ptr = getRPointer<pitch>(s, w_ptr, segment.write_step, segment.max_delay, false, min_delay);
+        FixedPosition secondary_r_ptr = getRPointer<pitch>(s, w_ptr, segment.old_write_step, segment.old_max_delay,
+                                                           true, min_delay);
+        // For the smallest values of s, we use a "smoothing window": we calculate the values from
+        // where the read pointer would be if it had continued its trajectory, and fade from the old
+        // values to the new values.
+        
+        // Normally, we want to preserve power across the transiton. However, if we are
+        // Not shifting the pitch up or down, we want to preserve
+        return crossfade_table.fade_in[s] * getInBetween(delay_channel, r_ptr) +
+            crossfade_table.fade_out[s] * getInBetween(delay_channel, secondary_r_ptr);
+    }
+}
+
+// The trajectory engine's delay past the min delay is base + scale * the
+// table value. Pitching down, it grows with the table from 0 to the depth.
+// Pitching up, it shrinks from the depth back towards 0, kept a crossfade's
+// length clear of the write position like the sawtooth is. With the sawtooth
+// table, the read head lands where getRPointer puts it.
+static void getTrajectorySweep(float write_step, float max_delay, double& base, double& scale)
+{
+    if (write_step < 0) {
+        base = 0;
+        scale = max_delay;
+    } else if (write_step > 0) {
+        base = smoothing_window + max_delay;
+        scale = -max_delay;
+    } else {
+        base = 0;
+        scale = 0;
+    }
+}
+
+FixedPosition SplutterEngine::getTrajectoryRPointer(const TrajectoryTable& table, double phase, double base,
+                                                              double scale, FixedPosition w_ptr, FixedPosition min_delay)
+{
+    // A drawn curve can head towards the write position as the old grain
+    // fades out, so the delay stops at the min delay.
+    FixedPosition r_ptr = w_ptr - min_delay - toFixed(std::max(base + scale * table.getValue(phase), 0.0));
+    return r_ptr + (r_ptr < 0) * ((FixedPosition) buffer_length << fixed_shift);
+}
+
+template <bool crossfading>
+float SplutterEngine::getWetTrajectory(const Segment& segment, int sample, const float* delay_channel)
+{
+    const int s = segment.s + sample;
+    const FixedPosition w_ptr = (FixedPosition) (segment.w_ptr + sample) << fixed_shift;
+    const FixedPosition min_delay = segment.min_delay + sample * segment.min_delay_inc;
+    if (! crossfading) {
+        FixedPosition r_ptr = getTrajectoryRPointer(*segment.old_trajectory, s * segment.old_grain_phase_inc,
+                                                    segment.old_trajectory_base, segment.old_trajectory_scale,
+                                                    w_ptr, min_delay);
+        return getInBetween(delay_channel, r_ptr);
+    } else {
+        // The same crossfade as the sawtooth, from the old grain carried on
+        // past its end into the new one.
+        FixedPosition r_ptr = getTrajectoryRPointer(*segment.trajectory, s * segment.grain_phase_inc,
+                                                    segment.trajectory_base, segment.trajectory_scale,
+                                                    w_ptr, min_delay);
+        FixedPosition secondary_r_ptr = getTrajectoryRPointer(*segment.old_trajectory, 1.0 + s * segment.old_grain_phase_inc,
+                                                              segment.old_trajectory_base, segment.old_trajectory_scale,
+                                                              w_ptr, min_delay);
+        return crossfade_table.fade_in[s] * getInBetween(delay_channel, r_ptr) +
+            crossfade_table.fade_out[s] * getInBetween(delay_channel, secondary_r_ptr);
+    }
+}
+
+const TrajectoryTable* SplutterEngine::getTrajectory(int shape) const
+{
+    if (shape >= 0 && shape < NUM_BUILT_IN_SHAPES) {
+        return &built_in_trajectories.shapes[shape];
+    }
+    return &drawn_tables[drawn_table];
+}
+
+bool SplutterEngine::isTrajectoryInUse(const TrajectoryTable* table) const
+{
+    // The outgoing program only reads its tables while it is fading out.
+    return trajectory == table || old_trajectory == table
+        || (program_fade_pos < program_fade_len
+            && (fading_engine.trajectory == table || fading_engine.old_trajectory == table));
+}
+
+void SplutterEngine::takeDrawnTrajectory()
+{
+    // The engines may still be reading the current copy, in the grain that
+    // is fading out or in the outgoing program, so a new curve waits in
+    // drawn_uploads until the other copy is free. Later curves replace it
+    // there in the meantime.
+    const int spare = 1 - drawn_table;
+    if (isTrajectoryInUse(&drawn_tables[spare]) || ! drawn_uploads.acquire()) {
+        return;
+    }
+    drawn_tables[spare] = drawn_uploads.getFront();
+    drawn_table = spare;
+}
+
+void SplutterEngine::setDrawnTrajectory(const float* points, int numPoints)
+{
+    num_drawn_points = std::min(std::max(numPoints, 0), max_drawn_points);
+    std::copy(points, points + num_drawn_points, drawn_points);
+    drawn_uploads.getBack().setFromPoints(drawn_points, num_drawn_points);
+    drawn_uploads.publish();
+}
+
+int SplutterEngine::getDrawnTrajectory(float* points) const
+{
+    std::copy(drawn_points, drawn_points + num_drawn_points, points);
+    return num_drawn_points;
+}
+
+void SplutterEngine::scheduleGrainBoundaries(int startSample, int numSamples)
+{
+    num_grain_boundaries = 0;
+    next_grain_boundary = 0;
+    
+    if (grains_locked) {
+        // Grains start on multiples of the note value, on the first sample at
+        // or after the exact position. The offsets only depend on where the
+        // block sits in the song, so a bounce lands them where playback does.
+        const double beats_per_grain = note_value_beats[grain_note_value];
+        const double samples_per_beat = fs * 60.0 / host_bpm;
+        const double start_ppq = block_ppq + startSample / samples_per_beat;
+        double grain = ceil(start_ppq / beats_per_grain);
+        while (num_grain_boundaries < max_grain_boundaries) {
+            double exact = (grain * beats_per_grain - block_ppq) * samples_per_beat;
+            // Hosts round the PPQ position, so a boundary that is a hair past a
+            // sample still counts as on it.
+            int boundary = std::max((int) ceil(exact - ppq_tolerance), startSample);
+            if (boundary >= numSamples) {
+                break;
+            }
+            if (boundary == startSample) {
+                // Segments can only end on a boundary, so one on the very
+                // first sample resets straight away.
+                samples_since_reset = 0;
+            } else {
+                grain_boundaries[num_grain_boundaries++] = boundary;
+            }
+            grain_carry = boundary - exact;
+            grain += 1;
+        }
+        return;
+    }
+    
+    // Free running: the grain we are in finishes at its length minus the
+    // carry, counted from its own start. Its length is lfo_len until the
+    // crossfade is over, and old_lfo_len from then on.
+    double length = samples_since_reset < smoothing_window ? lfo_len : old_lfo_len;
+    long grain_start = startSample - samples_since_reset;
+    while (num_grain_boundaries < max_grain_boundaries) {
+        double end = length - grain_carry;
+        long boundary = std::max(grain_start + (long) ceil(end), (long) startSample);
+        if (boundary >= numSamples) {
+            break;
+        }
+        if (boundary == startSample) {
+            samples_since_reset = 0;
+        } else {
+            grain_boundaries[num_grain_boundaries++] = (int) boundary;
+        }
+        grain_carry = (boundary - grain_start) - end;
+        grain_start = boundary;
+        length = lfo_len;
+    }
+}
+
+float SplutterEngine::getWetOverlap(const Segment& segment, int sample, const float* delay_channel)
+{
+    const FixedPosition w_ptr = (FixedPosition) (segment.w_ptr + sample) << fixed_shift;
+    const FixedPosition min_delay = segment.min_delay + sample * segment.min_delay_inc;
+    const double phase = segment.head_phase + sample * segment.head_phase_inc;
+    
+    // Phases, delays and window gains for all the heads in one pass, then the
+    // reads for the heads in use.
+    FixedPosition r_ptr[max_heads];
+    float gain[max_heads];
+    for (int head = 0; head < max_heads; ++head) {
+        double head_phase = phase + head_spacing[head];
+        head_phase -= (int) head_phase;
+        FixedPosition r = w_ptr - min_delay - toFixed(head_offset[head] + head_slope[head] * head_phase);
+        r_ptr[head] = r + (r < 0) * ((FixedPosition) buffer_length << fixed_shift);
+        
+        // A phase just under 1 can round up to the end of the table, so the
+        // last interval is the furthest the lookup starts from.
+        float index = head_phase * window_table_size;
+        int i = std::min((int) index, window_table_size - 1);
+        gain[head] = linInterpolation(grain_window.gain[i], grain_window.gain[i + 1], index - i);
+    }
+    
+    float wet = 0;
+    for (int head = 0; head < overlap_heads; ++head) {
+        wet += gain[head] * getInBetween(delay_channel, r_ptr[head]);
+    }
+    // Hann windows spaced evenly add up to half the number of heads.
+    return wet * 2 / overlap_heads;
+}
+
+int SplutterEngine::getSegmentLength(int sample, int numSamples)
+{
+    long length = numSamples - sample;
+    length = std::min(length, buffer_length - buffer_write_pos);
+    if (buffer_write_pos == 0) {
+        length = 1; // so the guard sample is mirrored before anything reads it
+    }
+    if (samples_since_reset < smoothing_window) {
+        length = std::min(length, (long) (smoothing_window - samples_since_reset));
+    }
+    if (next_grain_boundary < num_grain_boundaries) {
+        length = std::min(length, (long) (grain_boundaries[next_grain_boundary] - sample));
+    }
+    if (pitch_regime == pitch_overlap) {
+        // Up to the next time a head wraps around.
+        double position = head_phase * overlap_heads;
+        double to_wrap = (1 - (position - floor(position))) * lfo_len / overlap_heads;
+        length = std::min(length, (long) ceil(to_wrap));
+    } else if (pitch_regime == pitch_spectral) {
+        length = std::min(length, (long) (PhaseVocoder::latency - dry_delay_pos));
+    }
+    if (min_delay_steps_left > 0) {
+        length = std::min(length, (long) min_delay_steps_left);
+    } else if (min_delay_actual != min_delay_target) {
+        length = 1; // the sample before the delay snaps to its target
+    }
+    return (int) std::max(length, 1L);
+}
+
+void SplutterEngine::advanceSegment(int sample, int length)
+{
+    // every sample, the write position in the delay array steps forward one
+    buffer_write_pos += length;
+    if (buffer_write_pos >= buffer_length) {
+        buffer_write_pos = 0;
+    }
+    
+    if (min_delay_steps_left > 0) {
+        min_delay_actual += length * min_delay_step;
+        min_delay_steps_left -= length;
+        if (min_delay_steps_left == 0 && glide_pos < glide_len) {
+            planGlidePiece();
+        }
+    } else {
+        min_delay_actual = min_delay_target;
+    }
+    
+    if (pitch_regime == pitch_overlap) {
+        double phase = head_phase + length / (double) lfo_len;
+        for (int head = 0; head < overlap_heads; ++head) {
+            if (floor(phase + head_spacing[head]) != floor(head_phase + head_spacing[head])) {
+                latchHead(head);
+            }
+        }
+        head_phase = phase - floor(phase);
+    } else if (pitch_regime == pitch_spectral) {
+        dry_delay_pos += length;
+        if (dry_delay_pos == PhaseVocoder::latency) {
+            dry_delay_pos = 0;
+        }
+    }
+    
+    samples_since_reset += length;
+    if (samples_since_reset == smoothing_window) {
+        old_lfo_len = lfo_len;
+        old_max_delay = max_delay;
+        old_write_step = write_step;
+        old_trajectory = trajectory;
+    }
+    if (next_grain_boundary < num_grain_boundaries
+        && grain_boundaries[next_grain_boundary] == sample + length) {
+        samples_since_reset = 0;
+        next_grain_boundary++;
+    }
+}
+
+template <typename SampleType>
+void SplutterEngine::process(SampleType* const* channels, int numChannels, int numSamples)
+{
+    SPLUTTER_ZONE("processBlock");
+    if (bypassed) {
+        bypassed = false;
+        // The vocoder didn't hear the bypassed stretch, so it starts again
+        // rather than playing what it held from before.
+        if (active_engine == engine_spectral) {
+            for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+                vocoders[channel].reset();
+            }
+        }
+    }
+    
+    numChannels = std::min(NUM_CHANNELS, numChannels);
+    const int fade_samples = std::min(numSamples, bypass_fade_pos);
+    for (int channel = 0; channel < numChannels; ++channel) {
+        std::copy(channels[channel], channels[channel] + fade_samples,
+                  getBypassDry(channel, (SampleType*) nullptr));
+    }
+    
+    processKeyedSamples(channels, numChannels, numSamples);
+    
+    // Fade back in from dry.
+    SPLUTTER_ZONE("bypass fade");
+    for (int channel = 0; channel < numChannels; ++channel) {
+        SampleType* channelData = channels[channel];
+        const SampleType* dry = getBypassDry(channel, channelData);
+        for (int sample = 0; sample < fade_samples; ++sample) {
+            const float fade = (float) (bypass_fade_pos - sample - 1) / (float) bypass_fade_len;
+            channelData[sample] += fade * (dry[sample] - channelData[sample]);
+        }
+    }
+    bypass_fade_pos -= fade_samples;
+}
+
+template <typename SampleType>
+void SplutterEngine::processBypassed(SampleType* const* channels, int numChannels, int numSamples)
+{
+    SPLUTTER_ZONE("processBlockBypassed");
+    ScopedFlushDenormals noDenormals;
+    bypassed = true;
+    // Keys still go up and down while bypassed, but not sample by sample.
+    for (int event = 0; event < num_key_events; ++event) {
+        takeKeyEvent(key_events[event]);
+    }
+    num_key_events = 0;
+    if (! delay_buffer.isAllocated()) {
+        return;
+    }
+    
+    // The start of the bypass still runs in full while it fades to dry, and
+    // only the rest of the block takes the write-only path.
+    numChannels = std::min(NUM_CHANNELS, numChannels);
+    const int fade_samples = std::min(numSamples, bypass_fade_len - bypass_fade_pos);
+    if (fade_samples > 0) {
+        for (int channel = 0; channel < numChannels; ++channel) {
+            std::copy(channels[channel], channels[channel] + fade_samples,
+                      getBypassDry(channel, (SampleType*) nullptr));
+        }
+        processSamples(channels, numChannels, fade_samples);
+        for (int channel = 0; channel < numChannels; ++channel) {
+            SampleType* channelData = channels[channel];
+            const SampleType* dry = getBypassDry(channel, channelData);
+            for (int sample = 0; sample < fade_samples; ++sample) {
+                const float fade = (float) (bypass_fade_pos + sample + 1) / (float) bypass_fade_len;
+                channelData[sample] += fade * (dry[sample] - channelData[sample]);
+            }
+        }
+        bypass_fade_pos += fade_samples;
+    }
+    if (fade_samples < numSamples) {
+        writeHistoryOnly(channels, numChannels, fade_samples, numSamples - fade_samples);
+    }
+}
+
+template <typename SampleType>
+void SplutterEngine::writeHistoryOnly(SampleType* const* channels, int numChannels, int startSample, int numSamples)
+{
+    // No reads, no feedback and no mix: the input goes into the history, and
+    // out again as it came in. If the EQ sits before the delay or in the
+    // feedback loop, the input goes through it, so the history holds what the
+    // full kernel would have written without echoes, and the filters stay warm.
+    SPLUTTER_ZONE("history only");
+    FilterChain* chains = nullptr;
+    if (filter_regime != filters_flat && eq_placement != eq_post_wet) {
+        chains = filter_chains[eq_placement];
+    }
+    // The spectral engine's dry delay keeps running, so the bypassed signal
+    // stays lined up with the latency the host is compensating for.
+    const bool delay_dry = active_engine == engine_spectral;
+    
+    long w_ptr = buffer_write_pos;
+    int dry_pos = dry_delay_pos;
+    for (int channel = 0; channel < numChannels; ++channel) {
+        float* delay_channel = delay_buffer.getWritePointer(channel);
+        SampleType* channelData = channels[channel] + startSample;
+        double* dry_line = dry_delay[channel];
+        w_ptr = buffer_write_pos;
+        dry_pos = dry_delay_pos;
+        for (int sample = 0; sample < numSamples; ++sample) {
+            const SampleType dry = channelData[sample];
+            const float in = chains != nullptr ? chains[channel].tick(dry) : (float) dry;
+            delay_channel[w_ptr] = in;
+            if (w_ptr == 0) {
+                delay_channel[buffer_length] = in;
+            }
+            if (++w_ptr == buffer_length) {
+                w_ptr = 0;
+            }
+            if (delay_dry) {
+                channelData[sample] = dry_line[dry_pos];
+                dry_line[dry_pos] = dry;
+                if (++dry_pos == PhaseVocoder::latency) {
+                    dry_pos = 0;
+                }
+            }
+        }
+    }
+    buffer_write_pos = w_ptr;
+    if (delay_dry) {
+        dry_delay_pos = dry_pos;
+    }
+}
+
+template <typename SampleType>
+void SplutterEngine::processKeyedSamples(SampleType* const* channels, int numChannels, int numSamples)
+{
+    if (parameters.key_mode == key_off) {
+        // The keys are still followed, for when a key mode comes on, but the
+        // block isn't split, so MIDI sent to the plugin doesn't change how
+        // the parameter ramps run.
+        for (int event = 0; event < num_key_events; ++event) {
+            takeKeyEvent(key_events[event]);
+        }
+        num_key_events = 0;
+        key_shape_waiting = false;
+        key_crossfade_pending = false;
+    }
+    if (num_key_events == 0 && ! key_shape_waiting && ! key_crossfade_pending) {
+        processSamples(channels, numChannels, numSamples);
+        return;
+    }
+    
+    // Each part runs as a block of its own, with the transport moved on to
+    // where it starts, so a key lands on its sample without anything in the
+    // segments looking out for it.
+    SPLUTTER_ZONE("keys");
+    SampleType* part[NUM_CHANNELS];
+    const double start_ppq = block_ppq;
+    const double beats_per_sample = host_bpm / (60.0 * fs);
+    int event = 0;
+    int start = 0;
+    while (start < numSamples) {
+        while (event < num_key_events && key_events[event].offset <= start) {
+            takeKeyEvent(key_events[event++]);
+        }
+        int end = numSamples;
+        if (event < num_key_events) {
+            end = std::min(end, key_events[event].offset);
+        }
+        if (key_shape_waiting && samples_since_reset > 0 && samples_since_reset <= smoothing_window) {
+            end = std::min(end, start + smoothing_window + 1 - samples_since_reset);
+        }
+        if (key_crossfade_pending && program_fade_pos < program_fade_len) {
+            end = std::min(end, start + program_fade_len - program_fade_pos);
+        }
+        for (int channel = 0; channel < numChannels; ++channel) {
+            part[channel] = channels[channel] + start;
+        }
+        block_ppq = start_ppq + start * beats_per_sample;
+        processSamples(part, numChannels, end - start);
+        start = end;
+    }
+    while (event < num_key_events) {
+        takeKeyEvent(key_events[event++]);
+    }
+    num_key_events = 0;
+    block_ppq = start_ppq;
+}
+
+template <typename SampleType>
+void SplutterEngine::processSamples(SampleType* const* channels, int numChannels, int numSamples)
+{
+    {
+        SPLUTTER_ZONE("parameters");
+        // A new program waits until the last switch has finished fading, and
+        // nothing is read while the parameters are held. Until then the old
+        // values are kept.
+        if (! hold_parameters && program_switch_pending && program_fade_pos >= program_fade_len) {
+            program_switch_pending = false;
+            beginProgramSwitch();
+        } else if (! hold_parameters && ! program_switch_pending) {
+            calculateParameters();
+            if (delay_jump_pending && program_fade_pos >= program_fade_len) {
+                beginDelayJump();
+            } else if (key_crossfade_pending && program_fade_pos >= program_fade_len) {
+                beginKeyCrossfade();
+            }
+        }
+    }
+    
+    ScopedFlushDenormals noDenormals;
+    
+    if (! delay_buffer.isAllocated()) {
+        return;
+    }
+    
+    // The outgoing program goes first, so the live one writes the delay
+    // history last and reads back only its own writes.
+    const int fade_samples = std::min(numSamples, program_fade_len - program_fade_pos);
+    const long w_ptr = buffer_write_pos;
+    if (fade_samples > 0) {
+        processFadingEngine(channels, numChannels, fade_samples);
+    }
+    
+    processSegments(channels, numChannels, numSamples,
+                    feedback_level->prev_val, feedback_level->curr_val, dry_wet->prev_val, dry_wet->curr_val);
+    
+    SPLUTTER_ZONE("program fade");
+    if (fade_samples > 0) {
+        blendFadingHistory(w_ptr, numChannels, fade_samples);
+    }
+    
+    for (int channel = 0; channel < numChannels && fade_samples > 0; ++channel) {
+        SampleType* channelData = channels[channel];
+        const SampleType* fading = getFadeOutput(channel, channelData);
+        for (int sample = 0; sample < fade_samples; ++sample) {
+            // Both programs carry the same dry signal, so a linear fade keeps
+            // it steady.
+            const float fade = (float) (program_fade_pos + sample + 1) / (float) program_fade_len;
+            channelData[sample] = fading[sample] + fade * (channelData[sample] - fading[sample]);
+        }
+    }
+    program_fade_pos += fade_samples;
+    
+    for (int i = 0; i < NUM_PARAMETERS; ++i) {
+        ramps[i].prev_val = ramps[i].curr_val;
+    }
+    prev_feedback_matrix = feedback_matrix;
+}
+
+template <typename SampleType>
+void SplutterEngine::processSegments(SampleType* const* channels, int numChannels, int numSamples,
+                                     float feedback_from, float feedback_to, float wet_from, float wet_to)
+{
+    // The block is cut into segments at every event that changes the
+    // per-sample bookkeeping. Each segment runs through every channel from the
+    // same starting state, then the state is advanced once.
+    SPLUTTER_ZONE("segments");
+    // A mono input has nothing to cross-feed.
+    const int feedback = crossesChannels(feedback_regime) && numChannels < NUM_CHANNELS
+        ? getFeedbackRegime(true, false, saturates(feedback_regime)) : feedback_regime;
+    SegmentProcessor<SampleType> segment_processor =
+        getKernel<SampleType>(pitch_regime, feedback, filter_regime, mix_regime);
+    Segment segment;
+    segment.feedback_inc = (feedback_to - feedback_from) / numSamples;
+    segment.wet_inc = (wet_to - wet_from) / numSamples;
+    // The matrix ramps from last block's routing to this block's, like the gains.
+    for (int i = 0; i < NUM_CHANNELS; ++i) {
+        for (int j = 0; j < NUM_CHANNELS; ++j) {
+            segment.feedback_matrix_inc.gains[i][j] =
+                (feedback_matrix.gains[i][j] - prev_feedback_matrix.gains[i][j]) / numSamples;
+        }
+    }
+    SampleType* segment_channels[NUM_CHANNELS];
+    
+    scheduleGrainBoundaries(0, numSamples);
+    for (int sample = 0; sample < numSamples; sample += segment.length) {
+        // Only very large blocks of short grains fill the schedule.
+        if (next_grain_boundary == max_grain_boundaries) {
+            scheduleGrainBoundaries(sample, numSamples);
+        }
+        segment.offset = sample;
+        segment.length = getSegmentLength(sample, numSamples);
+        segment.w_ptr = buffer_write_pos;
+        segment.s = samples_since_reset;
+        segment.min_delay = min_delay_actual;
+        segment.min_delay_inc = min_delay_steps_left > 0 ? min_delay_step : 0;
+        segment.write_step = toFixed(write_step);
+        segment.max_delay = toFixed(max_delay);
+        segment.old_write_step = toFixed(old_write_step);
+        segment.old_max_delay = toFixed(old_max_delay);
+        segment.feedback_gain = feedback_from + sample * segment.feedback_inc;
+        segment.wet_gain = wet_from + sample * segment.wet_inc;
+        segment.head_phase = head_phase;
+        segment.head_phase_inc = 1.0 / lfo_len;
+        segment.trajectory = trajectory;
+        segment.old_trajectory = old_trajectory;
+        getTrajectorySweep(write_step, max_delay, segment.trajectory_base, segment.trajectory_scale);
+        getTrajectorySweep(old_write_step, old_max_delay, segment.old_trajectory_base, segment.old_trajectory_scale);
+        segment.grain_phase_inc = 1.0 / lfo_len;
+        segment.old_grain_phase_inc = 1.0 / old_lfo_len;
+        segment.dry_pos = dry_delay_pos;
+        for (int i = 0; i < NUM_CHANNELS; ++i) {
+            for (int j = 0; j < NUM_CHANNELS; ++j) {
+                segment.feedback_matrix.gains[i][j] = prev_feedback_matrix.gains[i][j]
+                    + sample * segment.feedback_matrix_inc.gains[i][j];
+            }
+        }
+        
+        for (int channel = 0; channel < numChannels; ++channel) {
+            segment_channels[channel] = channels[channel] + sample;
+        }
+        (this->*segment_processor)(segment_channels, numChannels, segment);
+        if (segment.w_ptr == 0) {
+            // Reads just behind the wrap interpolate into the guard sample.
+            for (int channel = 0; channel < numChannels; ++channel) {
+                float* delay_channel = delay_buffer.getWritePointer(channel);
+                delay_channel[buffer_length] = delay_channel[0];
+            }
+        }
+        advanceSegment(sample, segment.length);
+    }
+    
+    placement_fade_pos = std::min(placement_fade_pos + numSamples, placement_fade_len);
+}
+
+template <typename SampleType>
+void SplutterEngine::processFadingEngine(SampleType* const* input, int numChannels, int numSamples)
+{
+    SPLUTTER_ZONE("outgoing program");
+    SampleType* channels[NUM_CHANNELS];
+    for (int channel = 0; channel < numChannels; ++channel) {
+        channels[channel] = getFadeOutput(channel, (SampleType*) nullptr);
+        std::copy(input[channel], input[channel] + numSamples, channels[channel]);
+    }
+    
+    const long w_ptr = buffer_write_pos;
+    std::swap(static_cast<EngineState&>(*this), fading_engine);
+    // Only the pitch regime can change on its own, at the grain resets, and
+    // the EQ placement fade can run out.
+    pitch_regime = getPitchRegime();
+    if (filter_regime == filters_crossfade && placement_fade_pos >= placement_fade_len) {
+        filter_regime = filters_pre + eq_placement;
+    }
+    processSegments(channels, numChannels, numSamples, fading_feedback, fading_feedback, fading_wet, fading_wet);
+    std::swap(static_cast<EngineState&>(*this), fading_engine);
+    buffer_write_pos = w_ptr;
+    
+    // Keep what it wrote, for blendFadingHistory.
+    for (int channel = 0; channel < numChannels; ++channel) {
+        const float* delay_channel = delay_buffer.getWritePointer(channel);
+        long position = w_ptr;
+        for (int sample = 0; sample < numSamples; ++sample) {
+            fade_history[channel][sample] = delay_channel[position];
+            if (++position == buffer_length) {
+                position = 0;
+            }
+        }
+    }
+}
+
+void SplutterEngine::blendFadingHistory(long w_ptr, int numChannels, int numSamples)
+{
+    // With feedback, each program writes its own echoes into the history. The
+    // write is faded along with the output, or the history would step from
+    // one program's echoes to the other's and the step would come back round
+    // a delay later.
+    for (int channel = 0; channel < numChannels; ++channel) {
+        float* delay_channel = delay_buffer.getWritePointer(channel);
+        long position = w_ptr;
+        for (int sample = 0; sample < numSamples; ++sample) {
+            const float fade = (float) (program_fade_pos + sample + 1) / (float) program_fade_len;
+            const float old_write = fade_history[channel][sample];
+            delay_channel[position] = old_write + fade * (delay_channel[position] - old_write);
+            if (position == 0) {
+                delay_channel[buffer_length] = delay_channel[0];
+            }
+            if (++position == buffer_length) {
+                position = 0;
+            }
+        }
+    }
+}
+
+template <typename SampleType, int pitch, int feedback, int filters, int mix>
+void SplutterEngine::processSegment(SampleType* const* channels, int numChannels, const Segment& segment)
+{
+    // Segments end where the crossfade does, so this holds for the whole segment.
+    const bool crossfading = (pitch == pitch_up || pitch == pitch_down || pitch == pitch_mixed || pitch == pitch_trajectory)
+        && segment.s < smoothing_window;
+    // Reading, filtering and mixing share one loop per sample, so they are
+    // timed together, under the regimes that pick which of them run.
+    SPLUTTER_ZONE_DETAIL(crossfading ? "kernel, crossfading" : "kernel", pitch_regime_names[pitch],
+                         feedback_regime_names[feedback], filter_regime_names[filters], mix_regime_names[mix]);
+    if (crossesChannels(feedback)) {
+        if (crossfading) {
+            processFrames<SampleType, pitch, feedback, filters, mix, true>(channels, segment);
+        } else {
+            processFrames<SampleType, pitch, feedback, filters, mix, false>(channels, segment);
+        }
+        return;
+    }
+    for (int channel = 0; channel < numChannels; ++channel) {
+        if (crossfading) {
+            processChannel<SampleType, pitch, feedback, filters, mix, true>(channel, channels[channel], segment);
+        } else {
+            processChannel<SampleType, pitch, feedback, filters, mix, false>(channel, channels[channel], segment);
+        }
+    }
+}
+
+template <typename SampleType, int pitch, int feedback, int filters, int mix, bool crossfading>
+void SplutterEngine::processChannel(int channel, SampleType* channelData, const Segment& segment)
+{
+    SegmentLane<SampleType> lane = getLane(channel, channelData, segment);
+    const PlacementBlend blend = getPlacementBlend();
+    
+    for (int sample = 0; sample < segment.length; ++sample) {
+        const float feedback_gain = segment.feedback_gain + sample * segment.feedback_inc;
+        const float wet_gain = segment.wet_gain + sample * segment.wet_inc;
+        const float fade = getPlacementFade<filters>(segment, sample);
+        
+        SampleType dry;
+        float in;
+        float wet = readChannel<SampleType, pitch, feedback, filters, mix, crossfading>(lane, segment, sample, fade, blend,
+                                                                                      dry, in);
+        float unfiltered = in;
+        if (feedback == feedback_on) {
+            unfiltered += wet * feedback_gain;
+        } else if (feedback == feedback_saturated) {
+            unfiltered += lane.saturator->tick(wet * feedback_gain);
+        }
+        writeChannel<SampleType, pitch, feedback, filters, mix>(lane, sample, fade, blend, unfiltered, wet, dry, wet_gain);
+    }
+}
+
+template <typename SampleType, int pitch, int feedback, int filters, int mix, bool crossfading>
+void SplutterEngine::processFrames(SampleType* const* channels, const Segment& segment)
+{
+    // Each channel's feedback takes from every channel's wet, so the channels
+    // go through the segment side by side, a frame at a time, instead of one
+    // after the other.
+    SegmentLane<SampleType> lanes[NUM_CHANNELS];
+    for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+        lanes[channel] = getLane(channel, channels[channel], segment);
+    }
+    const PlacementBlend blend = getPlacementBlend();
+    
+    for (int sample = 0; sample < segment.length; ++sample) {
+        const float feedback_gain = segment.feedback_gain + sample * segment.feedback_inc;
+        const float wet_gain = segment.wet_gain + sample * segment.wet_inc;
+        const float fade = getPlacementFade<filters>(segment, sample);
+        
+        SampleType dry[NUM_CHANNELS];
+        float in[NUM_CHANNELS], wet[NUM_CHANNELS], fed_back[NUM_CHANNELS];
+        for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+            wet[channel] = readChannel<SampleType, pitch, feedback, filters, mix, crossfading>(
+                lanes[channel], segment, sample, fade, blend, dry[channel], in[channel]);
+        }
+        segment.feedback_matrix.applyRamped(segment.feedback_matrix_inc, (float) sample, wet, fed_back);
+        for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+            float feedback_term = fed_back[channel] * feedback_gain;
+            if (saturates(feedback)) {
+                feedback_term = lanes[channel].saturator->tick(feedback_term);
+            }
+            writeChannel<SampleType, pitch, feedback, filters, mix>(lanes[channel], sample, fade, blend,
+                                                                    in[channel] + feedback_term,
+                                                                    wet[channel], dry[channel], wet_gain);
+        }
+    }
+}
+
+template <typename SampleType>
+SegmentLane<SampleType> SplutterEngine::getLane(int channel, SampleType* channelData, const Segment& segment)
+{
+    SegmentLane<SampleType> lane;
+    lane.data = channelData;
+    lane.delay = delay_buffer.getWritePointer(channel);
+    lane.write = lane.delay + segment.w_ptr;
+    lane.dry_line = dry_delay[channel] + segment.dry_pos;
+    lane.vocoder = &vocoders[channel];
+    lane.pre_chain = &filter_chains[eq_pre_delay][channel];
+    lane.feedback_chain = &filter_chains[eq_in_feedback][channel];
+    lane.post_chain = &filter_chains[eq_post_wet][channel];
+    lane.saturator = &saturators[channel];
+    return lane;
+}
+
+PlacementBlend SplutterEngine::getPlacementBlend() const
+{
+    // While crossfading, each placement's filters are blended in by how much
+    // of the old and new routing they belong to.
+    PlacementBlend blend;
+    blend.pre_from = eq_placement_from == eq_pre_delay;
+    blend.pre_to = eq_placement == eq_pre_delay;
+    blend.feedback_from = eq_placement_from == eq_in_feedback;
+    blend.feedback_to = eq_placement == eq_in_feedback;
+    blend.post_from = eq_placement_from == eq_post_wet;
+    blend.post_to = eq_placement == eq_post_wet;
+    return blend;
+}
+
+template <int filters>
+float SplutterEngine::getPlacementFade(const Segment& segment, int sample) const
+{
+    if (filters == filters_crossfade) {
+        return std::min((float)(placement_fade_pos + segment.offset + sample) / (float) placement_fade_len, 1.0f);
+    }
+    return 1.0;
+}
+
+template <typename SampleType, int pitch, int feedback, int filters, int mix, bool crossfading>
+float SplutterEngine::readChannel(SegmentLane<SampleType>& lane, const Segment& segment, int sample,
+                                            float fade, const PlacementBlend& blend, SampleType& dry, float& in)
+{
+    // A fully dry block without feedback never needs to read the delay line.
+    // The vocoder still has to hear every sample, or its frames slip.
+    const bool needs_wet = mix != mix_dry || feedback != feedback_off || pitch == pitch_spectral;
+    
+    dry = lane.data[sample];
+    in = dry;
+    if (pitch == pitch_spectral) {
+        // Store this sample and take the one from a latency ago.
+        SampleType held = lane.dry_line[sample];
+        lane.dry_line[sample] = dry;
+        dry = held;
+    }
+    if (filters == filters_pre) {
+        in = lane.pre_chain->tick(in);
+    } else if (filters == filters_crossfade) {
+        float amount = linInterpolation(blend.pre_from, blend.pre_to, fade);
+        in += amount * (lane.pre_chain->tick(in) - in);
+    }
+    lane.write[sample] = in;
+    // This is necessary for when the delay time is set to 0.
+    
+    float wet = 0;
+    if (needs_wet) {
+        if (pitch == pitch_overlap) {
+            wet = getWetOverlap(segment, sample, lane.delay);
+        } else if (pitch == pitch_spectral) {
+            FixedPosition r_ptr = ((FixedPosition) (segment.w_ptr + sample) << fixed_shift)
+                - segment.min_delay - sample * segment.min_delay_inc;
+            r_ptr += (r_ptr < 0) * ((FixedPosition) buffer_length << fixed_shift);
+            wet = lane.vocoder->tick(getInBetween(lane.delay, r_ptr));
+        } else if (pitch == pitch_trajectory) {
+            wet = getWetTrajectory<crossfading>(segment, sample, lane.delay);
+        } else {
+            wet = getWetSaw<pitch, crossfading>(segment, sample, lane.delay);
+        }
+    }
+    return wet;
+}
+
+template <typename SampleType, int pitch, int feedback, int filters, int mix>
+void SplutterEngine::writeChannel(SegmentLane<SampleType>& lane, int sample, float fade,
+                                            const PlacementBlend& blend, float unfiltered, float wet, SampleType dry,
+                                            float wet_gain)
+{
+    if (filters == filters_feedback) {
+        lane.write[sample] = lane.feedback_chain->tick(unfiltered);
+    } else if (filters == filters_crossfade) {
+        float amount = linInterpolation(blend.feedback_from, blend.feedback_to, fade);
+        lane.write[sample] = unfiltered + amount * (lane.feedback_chain->tick(unfiltered) - unfiltered);
+    } else if (feedback != feedback_off) {
+        lane.write[sample] = unfiltered;
+    }
+    
+    if (mix != mix_dry) {
+        if (filters == filters_post) {
+            wet = lane.post_chain->tick(wet);
+        } else if (filters == filters_crossfade) {
+            float amount = linInterpolation(blend.post_from, blend.post_to, fade);
+            wet += amount * (lane.post_chain->tick(wet) - wet);
+        }
+    }
+    
+    // A fully dry block leaves the buffer as it is, unless the dry
+    // signal is being held back to match the vocoder.
+    if (mix == mix_wet) {
+        lane.data[sample] = wet;
+    } else if (mix == mix_blend) {
+        lane.data[sample] = wet * wet_gain + dry * (1 - wet_gain);
+    } else if (pitch == pitch_spectral) {
+        lane.data[sample] = dry;
+    }
+}
+
+// The getKernel overloads turn the runtime regimes into template arguments one
+// at a time, so every combination gets instantiated without spelling out the
+// whole table.
+template <typename SampleType, int pitch, int feedback, int filters>
+SplutterEngine::SegmentProcessor<SampleType> SplutterEngine::getKernel(int mix)
+{
+    switch (mix) {
+        case mix_dry: return &SplutterEngine::processSegment<SampleType, pitch, feedback, filters, mix_dry>;
+        case mix_wet: return &SplutterEngine::processSegment<SampleType, pitch, feedback, filters, mix_wet>;
+        default:      return &SplutterEngine::processSegment<SampleType, pitch, feedback, filters, mix_blend>;
+    }
+}
+
+template <typename SampleType, int pitch, int feedback>
+SplutterEngine::SegmentProcessor<SampleType> SplutterEngine::getKernel(int filters, int mix)
+{
+    switch (filters) {
+        case filters_flat:     return getKernel<SampleType, pitch, feedback, filters_flat>(mix);
+        case filters_pre:      return getKernel<SampleType, pitch, feedback, filters_pre>(mix);
+        case filters_feedback: return getKernel<SampleType, pitch, feedback, filters_feedback>(mix);
+        case filters_post:     return getKernel<SampleType, pitch, feedback, filters_post>(mix);
+        default:               return getKernel<SampleType, pitch, feedback, filters_crossfade>(mix);
+    }
+}
+
+template <typename SampleType, int pitch>
+SplutterEngine::SegmentProcessor<SampleType> SplutterEngine::getKernel(int feedback, int filters, int mix)
+{
+    switch (feedback) {
+        case feedback_off: return getKernel<SampleType, pitch, feedback_off>(filters, mix);
+        case feedback_on:  return getKernel<SampleType, pitch, feedback_on>(filters, mix);
+        case feedback_cross: return getKernel<SampleType, pitch, feedback_cross>(filters, mix);
+        case feedback_saturated: return getKernel<SampleType, pitch, feedback_saturated>(filters, mix);
+        default:           return getKernel<SampleType, pitch, feedback_cross_saturated>(filters, mix);
+    }
+}
+
+template <typename SampleType>
+SplutterEngine::SegmentProcessor<SampleType> SplutterEngine::getKernel(int pitch, int feedback, int filters, int mix)
+{
+    switch (pitch) {
+        case pitch_unity:    return getKernel<SampleType, pitch_unity>(feedback, filters, mix);
+        case pitch_up:       return getKernel<SampleType, pitch_up>(feedback, filters, mix);
+        case pitch_down:     return getKernel<SampleType, pitch_down>(feedback, filters, mix);
+        case pitch_overlap:  return getKernel<SampleType, pitch_overlap>(feedback, filters, mix);
+        case pitch_spectral: return getKernel<SampleType, pitch_spectral>(feedback, filters, mix);
+        case pitch_trajectory: return getKernel<SampleType, pitch_trajectory>(feedback, filters, mix);
+        default:             return getKernel<SampleType, pitch_mixed>(feedback, filters, mix);
+    }
+}
+
+template void SplutterEngine::process<float>(float* const*, int, int);
+template void SplutterEngine::process<double>(double* const*, int, int);
+template void SplutterEngine::processBypassed<float>(float* const*, int, int);
+template void SplutterEngine::processBypassed<double>(double* const*, int, int);
@@ -0,0 +1,569 @@
+/*
+  ==============================================================================
+
+    SplutterEngine.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../filterCalc/FilterCalc.h"
+#include "../filters/Biquad.h"
+#include "../filters/BiquadCascade.h"
+#include "../memory/DelayHistory.h"
+#include "../spectral/PhaseVocoder.h"
+#include "../trajectory/TrajectoryTable.h"
+#include "../trajectory/TripleBuffer.h"
+#include "../routing/FeedbackMatrix.h"
+#include "../saturation/AdaaSaturator.h"
+#include "../profiling/ZoneProfiler.h"
+#include <math.h> // pow
+#include <algorithm> // min, max
+#include <stdlib.h> // abs
+#include <stdint.h> // int64_t
+
+// The whole pitch delay, without JUCE: the delay history and its read heads,
+// the crossfades, the filters and the parameter ramps. The plugin and the C
+// API in splutter.h are both thin wrappers around it, so they share one
+// inner loop.
+
+#define PI 3.14159265
+#define NUM_PARAMETERS 7
+#define NUM_EQ_BANDS 4
+#define NUM_EQ_PARAMETERS (3 * NUM_EQ_BANDS)
+#define NUM_STORED_PARAMETERS (NUM_PARAMETERS + NUM_EQ_PARAMETERS)
+#define NUM_CHANNELS 2
+#define GET_IN_RANGE(sample) (sample += (sample < 0) ? buffer_length : 0)
+
+const float min_lfo_rate = 0.025;
+const float max_lfo_rate = 4.0;
+const float max_pitch_shift = 3.0 * 12.0;
+const float max_delay_slider_val = 4.0;
+
+// Where the lo/hi cut filters and the EQ sit in the signal path.
+enum EqPlacement { eq_pre_delay = 0, eq_in_feedback, eq_post_wet };
+#define NUM_EQ_PLACEMENTS 3
+const int placement_fade_len = 1024; // samples
+
+// What happens when the min delay changes. A glide slides the read position
+// across like a tape machine, which bends the pitch on the way; a jump fades
+// from a head at the old delay to one at the new over program_fade_len.
+enum DelayChange { delay_glide = 0, delay_jump };
+#define NUM_DELAY_CHANGES 2
+// The shape of a glide from the old delay to the new. Curved glides are run
+// as straight pieces of glide_piece_len samples, each ending on the curve.
+enum GlideCurve { glide_linear = 0, glide_ease, glide_exponential };
+#define NUM_GLIDE_CURVES 3
+const float min_glide_time = 0.01;
+const float max_glide_time = 4.0;
+const int glide_piece_len = 64; // samples
+
+// The pitch can be played from MIDI keys, as the interval from a root note.
+// A new interval starts with the next grain, or crossfades in at once from
+// the old one like a program switch.
+enum KeyMode { key_off = 0, key_next_grain, key_immediate };
+#define NUM_KEY_MODES 3
+// Key events for one block, and keys held at once. The last key held sets
+// the interval.
+const int max_key_events = 256;
+const int max_held_keys = 16;
+const int all_keys = -1; // a key event that lets every key go
+struct KeyEvent {
+    int offset; // samples into the block
+    int note;
+    bool down;
+};
+
+// processChannel is compiled once per combination of these regimes, and the
+// right one is picked once per block, so the per-sample loop doesn't test
+// any of them.
+//
+// pitch_mixed is for blocks where the old and new sawtooth go in different
+// directions (only while crossfading to a new pitch), and decides per read.
+// pitch_overlap, pitch_spectral and pitch_trajectory are the other engines,
+// which handle any pitch.
+enum PitchRegime { pitch_unity = 0, pitch_up, pitch_down, pitch_mixed, pitch_overlap, pitch_spectral, pitch_trajectory };
+// Feedback is off when it is 0 for the whole block. feedback_cross is for
+// blocks where the channels feed back into each other (see FeedbackMatrix.h),
+// which have to be run a frame at a time across all the channels. The
+// saturated regimes are the same two with the feedback going through the
+// channel's AdaaSaturator.
+enum FeedbackRegime { feedback_off = 0, feedback_on, feedback_cross, feedback_saturated, feedback_cross_saturated };
+inline constexpr bool crossesChannels(int feedback) {
+    return feedback == feedback_cross || feedback == feedback_cross_saturated;
+}
+inline constexpr bool saturates(int feedback) {
+    return feedback == feedback_saturated || feedback == feedback_cross_saturated;
+}
+// Filters are flat when both cuts are wide open and every EQ band is at
+// 0 dB. Otherwise the regime is the placement (filters_pre + EqPlacement), or
+// filters_crossfade for the blocks right after the placement changes, which
+// blends the old and new routing.
+enum FilterRegime { filters_flat = 0, filters_pre, filters_feedback, filters_post, filters_crossfade };
+// Fully dry or fully wet for the whole block, or anything in between.
+enum MixRegime { mix_dry = 0, mix_wet, mix_blend };
+
+// The sawtooth engine has one read head that jumps back at the end of each
+// grain. The overlap-add engine runs 2 to 4 windowed heads, spaced evenly
+// across the grain, which is smoother for long grains. The spectral engine
+// reads at the min delay and shifts the pitch with a phase vocoder, which is
+// smoothest on sustained sounds but adds latency. The trajectory engine is the
+// sawtooth with the read head following a table instead of a straight line,
+// so it can sweep the delay in any shape (see TrajectoryTable.h).
+enum Engine { engine_sawtooth = 0, engine_overlap, engine_spectral, engine_trajectory };
+const int max_heads = 4;
+const int window_table_size = 2048;
+
+const int smoothing_window = 1000;
+// over how many samples do we fade from the near to the far sound on
+// the sawtooth delay?
+
+// The grain length and min delay can follow the host tempo. Index 0 of the
+// sync choices is free running in seconds, the rest are note values.
+#define NUM_NOTE_VALUES 13
+// Grain starts are worked out once per block, so a block holds at most this
+// many before they are worked out again from where it got to.
+const int max_grain_boundaries = 32;
+const double ppq_tolerance = 1e-4; // samples
+
+// Switching programs fades from the old program's output to the new one's
+// over this many samples.
+const int program_fade_len = 2048; // samples
+// Going in and out of bypass fades over this many samples.
+const int bypass_fade_len = 1024; // samples
+
+// Read positions and delays in the delay history are 32.32 fixed point: the
+// top half is the sample index and the bottom half the fraction. Float keeps
+// only a few fractional bits that far into a multi-million sample buffer, and
+// the error grows with the position; here every position has the same 2^-32
+// resolution, wrapping is an exact add, and splitting off the index and the
+// fraction is a shift and a mask.
+typedef int64_t FixedPosition;
+const int fixed_shift = 32;
+const FixedPosition fixed_one = (FixedPosition) 1 << fixed_shift;
+const FixedPosition fixed_fraction_mask = fixed_one - 1;
+
+inline FixedPosition toFixed(double samples)
+{
+    return (FixedPosition) (samples * fixed_one);
+}
+
+// A stretch of a block between two events: the end of a crossfade, a grain
+// reset, the write pointer wrapping, the delay move finishing, or the end of
+// the block. None of the per-sample bookkeeping can change inside a segment,
+// so the kernels only count up from these starting values.
+struct Segment {
+    int offset;          // first sample of the segment within the block
+    int length;
+    long w_ptr;          // write position at the first sample
+    int s;               // samples since the grain reset at the first sample
+    FixedPosition min_delay;     // min_delay_actual at the first sample
+    FixedPosition min_delay_inc; // per sample
+    // The sawtooth of the grain being faded in and of the one before it.
+    FixedPosition write_step, max_delay;
+    FixedPosition old_write_step, old_max_delay;
+    float feedback_gain, feedback_inc;
+    float wet_gain, wet_inc;
+    double head_phase;     // overlap-add phase of head 0 at the first sample
+    double head_phase_inc; // per sample
+    // The trajectory engine's tables for the two grains, and how they map to
+    // the delay past the min delay: base + scale * the table value.
+    const TrajectoryTable* trajectory;
+    const TrajectoryTable* old_trajectory;
+    double trajectory_base, trajectory_scale;
+    double old_trajectory_base, old_trajectory_scale;
+    double grain_phase_inc, old_grain_phase_inc; // per sample
+    int dry_pos;           // spectral engine's dry delay position at the first sample
+    FeedbackMatrix<NUM_CHANNELS> feedback_matrix;     // at the first sample
+    FeedbackMatrix<NUM_CHANNELS> feedback_matrix_inc; // per sample
+};
+
+// The lo cut, hi cut and parametric EQ for one channel at one placement.
+struct FilterChain {
+    Biquad lo_cut;
+    Biquad hi_cut;
+    BiquadCascade<NUM_EQ_BANDS> eq;
+    
+    void clear() {
+        lo_cut.clear();
+        hi_cut.clear();
+        eq.clear();
+    }
+    
+    inline float tick(float in) {
+        return eq.tick(lo_cut.tick(hi_cut.tick(in)));
+    }
+};
+
+// One channel of a segment, as the kernels see it.
+template <typename SampleType>
+struct SegmentLane {
+    SampleType* data;     // the host buffer at the segment's first sample
+    float* delay;         // the delay history
+    float* write;         // the delay history at the segment's first sample
+    double* dry_line;     // the spectral engine's dry delay at the segment's first sample
+    PhaseVocoder* vocoder;
+    FilterChain* pre_chain;
+    FilterChain* feedback_chain;
+    FilterChain* post_chain;
+    AdaaSaturator* saturator;
+};
+
+// How much of each placement's filters run while the placement crossfades:
+// from is the old routing and to the new.
+struct PlacementBlend {
+    float pre_from, pre_to;
+    float feedback_from, feedback_to;
+    float post_from, post_to;
+};
+
+// Everything that moves as the engine runs, apart from the delay history and
+// its write position, which every engine shares. The processor derives from
+// this, so the kernels use it as plain members. While a program switch fades,
+// the outgoing program keeps running from a second copy, which is swapped in
+// for its pass over the block.
+struct EngineState {
+    int samples_since_reset;
+    
+    float write_step;
+    float lfo_len;
+    float max_delay;
+    
+    float old_write_step;
+    float old_lfo_len;
+    float old_max_delay;
+    
+    // The trajectory engine's shape, taken up along with the sawtooth above.
+    const TrajectoryTable* trajectory;
+    const TrajectoryTable* old_trajectory;
+    
+    // Where the current grain really ends is fractional: the reset lands on the
+    // first sample at or after it, and grain_carry is how far past the exact
+    // end that was. The next grain is shortened by the carry, so the grain
+    // period doesn't drift by rounding up every time.
+    double grain_carry;
+    int grain_boundaries[max_grain_boundaries]; // block offsets where s goes back to 0
+    int num_grain_boundaries;
+    int next_grain_boundary;
+    int grain_note_value; // the rate sync choice
+    bool grains_locked;   // grain starts follow the PPQ position this block
+    
+    // Overlap-add heads. They share one phase, and each keeps the delay
+    // shape it had when it last wrapped around, where its window is silent.
+    // Head h reads at min delay + head_offset[h] + head_slope[h] * its phase.
+    double head_phase;
+    int overlap_heads;
+    float head_spacing[max_heads];
+    float head_offset[max_heads];
+    float head_slope[max_heads];
+    
+    // Spectral engine. The dry signal is held back by the vocoder's latency
+    // so it lines up with the wet once the host compensates. Both point into
+    // one of the processor's two banks.
+    PhaseVocoder* vocoders;
+    double (*dry_delay)[PhaseVocoder::latency]; // wide enough for either host precision
+    int dry_delay_pos;
+    int active_engine;
+    
+    FixedPosition min_delay_actual;
+    FixedPosition min_delay_step;
+    FixedPosition min_delay_target; // where the current move is heading
+    int min_delay_steps_left; // samples of min_delay_step before snapping to the target
+    // A curved glide, planned a piece at a time: glide_pos of its glide_len
+    // samples are planned so far, from glide_from towards min_delay_target.
+    FixedPosition glide_from;
+    int glide_len;
+    int glide_pos;
+    int glide_curve;
+
+    // One set of filters per placement, so a placement that is fading in
+    // starts from clean state while the old one fades out.
+    FilterChain filter_chains[NUM_EQ_PLACEMENTS][NUM_CHANNELS];
+    int eq_placement;
+    int eq_placement_from;
+    int placement_fade_pos;
+    
+    // Stereo feedback routing, this block's and last block's.
+    FeedbackMatrix<NUM_CHANNELS> feedback_matrix;
+    FeedbackMatrix<NUM_CHANNELS> prev_feedback_matrix;
+    
+    // Saturation in the feedback loop: 0 when off, or the ADAA order.
+    int saturation;
+    AdaaSaturator saturators[NUM_CHANNELS];
+    
+    int pitch_regime, feedback_regime, filter_regime, mix_regime;
+};
+
+// Default frequencies of the EQ bands.
+static const float eq_default_freqs[NUM_EQ_BANDS] = {100.0, 500.0, 2500.0, 8000.0};
+
+// Every control, as plain values. The engine takes them up at the start of
+// each block, so they can be written between blocks from the thread that
+// runs them.
+struct EngineParameters {
+    float feedback;      // 0 to 0.95
+    float dry_wet;       // 0 to 1
+    float pitch_shift;   // semitones
+    float rate;          // grain length, seconds
+    float min_delay;     // seconds
+    float lo_cut;        // Hz
+    float hi_cut;        // Hz
+    float eq_freq[NUM_EQ_BANDS]; // Hz
+    float eq_gain[NUM_EQ_BANDS]; // dB
+    float eq_q[NUM_EQ_BANDS];
+    int eq_placement;    // EqPlacement
+    int rate_sync;       // index into the note values, 0 for free running
+    int delay_sync;
+    int engine;          // Engine
+    int overlap;         // heads for the overlap-add engine
+    int shape;           // the trajectory engine's TrajectoryShape
+    int stereo_feedback; // StereoFeedback
+    float feedback_width;
+    int saturation;      // 0 when off, or the ADAA order
+    float drive;         // dB
+    int delay_change;    // DelayChange
+    float glide_time;    // seconds
+    int glide_curve;     // GlideCurve
+    int key_mode;        // KeyMode
+    int root_note;       // MIDI note that plays no shift
+    
+    EngineParameters();
+};
+
+// Where a parameter's per-sample ramp runs from and to. a_param is this
+// block's value in the units the engine works in.
+struct ParameterRamp {
+    float a_param;
+    float curr_val;
+    float prev_val;
+    
+    ParameterRamp(): a_param(0), curr_val(0), prev_val(0) {}
+};
+
+// Calls to one engine must not overlap, apart from setDrawnTrajectory, which
+// can be called from any one other thread.
+class SplutterEngine : private EngineState
+{
+public:
+    SplutterEngine();
+    
+    // Takes the delay history from the shared pool and starts from silence.
+    // Allocates, so never call it from the audio thread. False if the
+    // history couldn't be had, and then process leaves the audio as it is.
+    bool prepare(double sampleRate);
+    // Gives the delay history back to the pool.
+    void release();
+    // Back to a new engine's state at sampleRate: default parameters, 120
+    // bpm, not bypassed and prepared from silence. The drawn trajectory is
+    // kept. Like prepare, it takes the history from the pool, and is false
+    // if it couldn't.
+    bool reset(double sampleRate);
+    
+    EngineParameters parameters;
+    
+    // Host tempo and position for the synced grain length and min delay.
+    // A bpm of 0 or less keeps the last tempo.
+    void setTransport(double bpm, double ppq, bool playing);
+    
+    // The parameters now hold a new program: fade from the running one to
+    // it, once any earlier switch has finished fading. Until then they are
+    // not taken up.
+    void switchProgram();
+    // While held, the parameters are not read at all, so they can be
+    // changed one by one without the engine taking up a half-set program.
+    void holdParameters(bool hold);
+    
+    // With a key mode on, the pitch shift is the last key held minus the
+    // root note, and stays there once every key is let go. Each event is
+    // taken up sampleOffset samples into the next block processed, so add
+    // them in order before processing it.
+    void addKeyEvent(int sampleOffset, int note, bool down);
+    
+    // Up to NUM_CHANNELS channels, in place. With fewer, the rest of the
+    // engine's channels sit idle.
+    template <typename SampleType>
+    void process(SampleType* const* channels, int numChannels, int numSamples);
+    // Keeps writing the input to the delay history, so the echoes are of
+    // what was just played when process is called again. Going in and out of
+    // bypass fades.
+    template <typename SampleType>
+    void processBypassed(SampleType* const* channels, int numChannels, int numSamples);
+    
+    // The spectral engine holds the signal back by its vocoder's latency.
+    int getLatencySamples() const { return latency_samples; }
+    
+    // Sends a curve for the drawn trajectory shape: numPoints evenly spaced
+    // values from 0 to 1 (at most max_drawn_points), across one grain. It
+    // never waits for the thread processing.
+    void setDrawnTrajectory(const float* points, int numPoints);
+    // The last curve sent, for saving. Returns the number of points.
+    int getDrawnTrajectory(float* points) const;
+    
+private:
+    ParameterRamp ramps[NUM_PARAMETERS];
+    ParameterRamp* const feedback_level = &ramps[0];
+    ParameterRamp* const dry_wet = &ramps[1];
+    ParameterRamp* const pitch_shift = &ramps[2];
+    ParameterRamp* const lfo_rate = &ramps[3];
+    ParameterRamp* const min_delay = &ramps[4];
+    ParameterRamp* const lo_cut = &ramps[5];
+    ParameterRamp* const hi_cut = &ramps[6];
+    
+    int fs; // Sample frequency
+    DelayHistory delay_buffer;
+    long buffer_write_pos;
+    float delay_samples;
+    
+    int buffer_length;
+    int latency_samples;
+    
+    // Host transport, set once per block.
+    double host_bpm;
+    double block_ppq;
+    bool transport_playing;
+    
+    // Keys. The block is split at each event, and where a new interval is
+    // waiting to go in: at the end of the grain crossfade when it starts
+    // with the next grain, and at the end of the running fade when it
+    // crossfades in.
+    KeyEvent key_events[max_key_events];
+    int num_key_events;
+    int held_keys[max_held_keys];
+    int num_held_keys;
+    int key_note; // -1 until a key is pressed
+    bool key_shape_waiting;
+    bool key_crossfade_pending;
+    
+    float samps_for_delay_move; // glide_time
+    // In jump mode a new min delay waits here for the crossfade to start.
+    bool delay_jump_pending;
+    FixedPosition delay_jump_target;
+    
+    PhaseVocoder vocoder_banks[2][NUM_CHANNELS];
+    double dry_delay_banks[2][NUM_CHANNELS][PhaseVocoder::latency];
+    
+    // Programs. switchProgram flags the switch, and processing copies the
+    // running engine into fading_engine, restarts the live one on the new
+    // program, and fades between their outputs.
+    bool program_switch_pending;
+    bool hold_parameters;
+    EngineState fading_engine;
+    float fading_feedback, fading_wet; // the outgoing program's gains, held still
+    int program_fade_pos;
+    // Where the outgoing program renders, in the host's precision.
+    float fade_output_float[NUM_CHANNELS][program_fade_len];
+    double fade_output_double[NUM_CHANNELS][program_fade_len];
+    float* getFadeOutput(int channel, float*) { return fade_output_float[channel]; }
+    double* getFadeOutput(int channel, double*) { return fade_output_double[channel]; }
+    float fade_history[NUM_CHANNELS][program_fade_len]; // what the outgoing program wrote to the delay history
+    
+    // Bypass keeps writing the input to the delay history, so the echoes are
+    // of what was just played when it comes back. bypass_fade_pos is how far
+    // the output is towards dry: 0 when active, bypass_fade_len when bypassed.
+    bool bypassed;
+    int bypass_fade_pos;
+    float bypass_dry_float[NUM_CHANNELS][bypass_fade_len];
+    double bypass_dry_double[NUM_CHANNELS][bypass_fade_len];
+    float* getBypassDry(int channel, float*) { return bypass_dry_float[channel]; }
+    double* getBypassDry(int channel, double*) { return bypass_dry_double[channel]; }
+    
+    // Drawn curves come in through drawn_uploads, and the audio thread copies
+    // the latest into whichever of drawn_tables no engine is reading, then
+    // switches to it. The points are kept for the saved state.
+    TripleBuffer<TrajectoryTable> drawn_uploads;
+    TrajectoryTable drawn_tables[2];
+    int drawn_table;
+    float drawn_points[max_drawn_points];
+    int num_drawn_points;
+    
+    // The kernels are compiled for float and double host buffers. The dry
+    // signal and the mix stay in the host's precision; the delay history and
+    // the wet path are float either way.
+    template <typename SampleType>
+    using SegmentProcessor = void (SplutterEngine::*)(SampleType* const* channels, int numChannels,
+                                                      const Segment& segment);
+    
+    // Everything a new engine starts with, apart from the drawn trajectory
+    // and the delay history.
+    void initialiseState();
+    float semitones_to_ratio(float interval);
+    bool resizeBuffer();
+    void calculateParameters();
+    void calculateEqCoefficients();
+    float getInBetween(const float* buffer, FixedPosition position);
+    float linInterpolation(float start, float end, float fract);
+    template <int pitch, bool crossfading>
+    float getWetSaw(const Segment& segment, int sample, const float* delay_channel);
+    template <int pitch>
+    FixedPosition getRPointer(int s, FixedPosition w_ptr, FixedPosition step, FixedPosition max, bool is_secondary,
+                              FixedPosition min_delay);
+    template <bool crossfading>
+    float getWetTrajectory(const Segment& segment, int sample, const float* delay_channel);
+    FixedPosition getTrajectoryRPointer(const TrajectoryTable& table, double phase, double base, double scale,
+                                        FixedPosition w_ptr, FixedPosition min_delay);
+    const TrajectoryTable* getTrajectory(int shape) const;
+    bool isTrajectoryInUse(const TrajectoryTable* table) const;
+    void takeDrawnTrajectory();
+    float getSyncedSeconds(int note_value, float free_seconds) const;
+    void scheduleGrainBoundaries(int startSample, int numSamples);
+    void latchHead(int head);
+    void setOverlapHeads(int heads);
+    void updateEngine();
+    float getWetOverlap(const Segment& segment, int sample, const float* delay_channel);
+    int getSegmentLength(int sample, int numSamples);
+    void advanceSegment(int sample, int length);
+    void updateEqPlacement();
+    void selectRegimes();
+    int getPitchRegime() const;
+    void planGlidePiece();
+    void beginFade();
+    void beginProgramSwitch();
+    void beginDelayJump();
+    void beginKeyCrossfade();
+    void takeKeyEvent(const KeyEvent& event);
+    void updateGrainShape();
+    void restartEngine();
+    
+    template <typename SampleType>
+    void writeHistoryOnly(SampleType* const* channels, int numChannels, int startSample, int numSamples);
+    template <typename SampleType>
+    void processKeyedSamples(SampleType* const* channels, int numChannels, int numSamples);
+    template <typename SampleType>
+    void processSamples(SampleType* const* channels, int numChannels, int numSamples);
+    template <typename SampleType>
+    void processSegments(SampleType* const* channels, int numChannels, int numSamples,
+                         float feedback_from, float feedback_to, float wet_from, float wet_to);
+    template <typename SampleType>
+    void processFadingEngine(SampleType* const* channels, int numChannels, int numSamples);
+    void blendFadingHistory(long w_ptr, int numChannels, int numSamples);
+    template <typename SampleType, int pitch, int feedback, int filters, int mix>
+    void processSegment(SampleType* const* channels, int numChannels, const Segment& segment);
+    template <typename SampleType, int pitch, int feedback, int filters, int mix, bool crossfading>
+    void processChannel(int channel, SampleType* channelData, const Segment& segment);
+    template <typename SampleType, int pitch, int feedback, int filters, int mix, bool crossfading>
+    void processFrames(SampleType* const* channels, const Segment& segment);
+    template <typename SampleType>
+    SegmentLane<SampleType> getLane(int channel, SampleType* channelData, const Segment& segment);
+    PlacementBlend getPlacementBlend() const;
+    template <int filters>
+    float getPlacementFade(const Segment& segment, int sample) const;
+    template <typename SampleType, int pitch, int feedback, int filters, int mix, bool crossfading>
+    float readChannel(SegmentLane<SampleType>& lane, const Segment& segment, int sample, float fade,
+                      const PlacementBlend& blend, SampleType& dry, float& in);
+    template <typename SampleType, int pitch, int feedback, int filters, int mix>
+    void writeChannel(SegmentLane<SampleType>& lane, int sample, float fade, const PlacementBlend& blend,
+                      float unfiltered, float wet, SampleType dry, float wet_gain);
+    template <typename SampleType, int pitch, int feedback, int filters>
+    SegmentProcessor<SampleType> getKernel(int mix);
+    template <typename SampleType, int pitch, int feedback>
+    SegmentProcessor<SampleType> getKernel(int filters, int mix);
+    template <typename SampleType, int pitch>
+    SegmentProcessor<SampleType> getKernel(int feedback, int filters, int mix);
+    template <typename SampleType>
+    SegmentProcessor<SampleType> getKernel(int pitch, int feedback, int filters, int mix);
+    
+    SplutterEngine(const SplutterEngine&) = delete;
+    SplutterEngine& operator=(const SplutterEngine&) = delete;
+};
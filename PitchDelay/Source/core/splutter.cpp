@@ -0,0 +1,208 @@
+/*
+  ==============================================================================
+
+    splutter.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "splutter.h"
+#include "SplutterEngine.h"
+#include <new>
+
+struct splutter {
+    SplutterEngine engine;
+};
+
+// The plugin's ranges, indexed by splutter_param.
+struct ParameterRange {
+    float min, max;
+    bool is_choice;
+};
+static const ParameterRange parameter_ranges[SPLUTTER_NUM_PARAMS] = {
+    { 0.0f, 0.95f, false },
+    { 0.0f, 1.0f, false },
+    { -max_pitch_shift, max_pitch_shift, false },
+    { min_lfo_rate, max_lfo_rate, false },
+    { 0.0f, max_delay_slider_val, false },
+    { 10.0f, 2000.0f, false },
+    { 200.0f, 20000.0f, false },
+    { 0, NUM_EQ_PLACEMENTS - 1, true },
+    { 0, NUM_NOTE_VALUES - 1, true },
+    { 0, NUM_NOTE_VALUES - 1, true },
+    { 0, engine_trajectory, true },
+    { 2, max_heads, true },
+    { 0, NUM_TRAJECTORY_SHAPES - 1, true },
+    { 0, NUM_STEREO_FEEDBACK_MODES - 1, true },
+    { 0.0f, max_feedback_width, false },
+    { 0, 2, true },
+    { 0.0f, max_saturation_drive, false },
+    { 0, NUM_DELAY_CHANGES - 1, true },
+    { min_glide_time, max_glide_time, false },
+    { 0, NUM_GLIDE_CURVES - 1, true },
+    { 0, NUM_KEY_MODES - 1, true },
+    { 0, 127, true },
+};
+
+static float clampTo(float value, float min, float max)
+{
+    return std::min(std::max(value, min), max);
+}
+
+int splutter_get_api_version(void)
+{
+    return SPLUTTER_API_VERSION;
+}
+
+splutter* splutter_create(double sample_rate)
+{
+    if (! (sample_rate > 0)) {
+        return nullptr;
+    }
+    splutter* s = new (std::nothrow) splutter;
+    if (s != nullptr && ! s->engine.prepare(sample_rate)) {
+        delete s;
+        return nullptr;
+    }
+    return s;
+}
+
+void splutter_destroy(splutter* s)
+{
+    if (s != nullptr) {
+        s->engine.release();
+        delete s;
+    }
+}
+
+int splutter_reset(splutter* s, double sample_rate)
+{
+    if (! (sample_rate > 0)) {
+        return 0;
+    }
+    return s->engine.reset(sample_rate) ? 1 : 0;
+}
+
+void splutter_set_param(splutter* s, splutter_param param, float value)
+{
+    if (param < 0 || param >= SPLUTTER_NUM_PARAMS || value != value) {
+        return;
+    }
+    const ParameterRange& range = parameter_ranges[param];
+    value = clampTo(value, range.min, range.max);
+    const int choice = (int) (value + 0.5f);
+    EngineParameters& parameters = s->engine.parameters;
+    switch (param) {
+        case SPLUTTER_PARAM_FEEDBACK: parameters.feedback = value; break;
+        case SPLUTTER_PARAM_DRY_WET: parameters.dry_wet = value; break;
+        case SPLUTTER_PARAM_PITCH_SHIFT: parameters.pitch_shift = value; break;
+        case SPLUTTER_PARAM_RATE: parameters.rate = value; break;
+        case SPLUTTER_PARAM_MIN_DELAY: parameters.min_delay = value; break;
+        case SPLUTTER_PARAM_LO_CUT: parameters.lo_cut = value; break;
+        case SPLUTTER_PARAM_HI_CUT: parameters.hi_cut = value; break;
+        case SPLUTTER_PARAM_EQ_PLACEMENT: parameters.eq_placement = choice; break;
+        case SPLUTTER_PARAM_RATE_SYNC: parameters.rate_sync = choice; break;
+        case SPLUTTER_PARAM_DELAY_SYNC: parameters.delay_sync = choice; break;
+        case SPLUTTER_PARAM_ENGINE: parameters.engine = choice; break;
+        case SPLUTTER_PARAM_OVERLAP: parameters.overlap = choice; break;
+        case SPLUTTER_PARAM_SHAPE: parameters.shape = choice; break;
+        case SPLUTTER_PARAM_STEREO_FEEDBACK: parameters.stereo_feedback = choice; break;
+        case SPLUTTER_PARAM_FEEDBACK_WIDTH: parameters.feedback_width = value; break;
+        case SPLUTTER_PARAM_SATURATION: parameters.saturation = choice; break;
+        case SPLUTTER_PARAM_DRIVE: parameters.drive = value; break;
+        case SPLUTTER_PARAM_DELAY_CHANGE: parameters.delay_change = choice; break;
+        case SPLUTTER_PARAM_GLIDE_TIME: parameters.glide_time = value; break;
+        case SPLUTTER_PARAM_GLIDE_CURVE: parameters.glide_curve = choice; break;
+        case SPLUTTER_PARAM_KEY_MODE: parameters.key_mode = choice; break;
+        case SPLUTTER_PARAM_ROOT_NOTE: parameters.root_note = choice; break;
+        default: break;
+    }
+}
+
+float splutter_get_param(const splutter* s, splutter_param param)
+{
+    const EngineParameters& parameters = s->engine.parameters;
+    switch (param) {
+        case SPLUTTER_PARAM_FEEDBACK: return parameters.feedback;
+        case SPLUTTER_PARAM_DRY_WET: return parameters.dry_wet;
+        case SPLUTTER_PARAM_PITCH_SHIFT: return parameters.pitch_shift;
+        case SPLUTTER_PARAM_RATE: return parameters.rate;
+        case SPLUTTER_PARAM_MIN_DELAY: return parameters.min_delay;
+        case SPLUTTER_PARAM_LO_CUT: return parameters.lo_cut;
+        case SPLUTTER_PARAM_HI_CUT: return parameters.hi_cut;
+        case SPLUTTER_PARAM_EQ_PLACEMENT: return parameters.eq_placement;
+        case SPLUTTER_PARAM_RATE_SYNC: return parameters.rate_sync;
+        case SPLUTTER_PARAM_DELAY_SYNC: return parameters.delay_sync;
+        case SPLUTTER_PARAM_ENGINE: return parameters.engine;
+        case SPLUTTER_PARAM_OVERLAP: return parameters.overlap;
+        case SPLUTTER_PARAM_SHAPE: return parameters.shape;
+        case SPLUTTER_PARAM_STEREO_FEEDBACK: return parameters.stereo_feedback;
+        case SPLUTTER_PARAM_FEEDBACK_WIDTH: return parameters.feedback_width;
+        case SPLUTTER_PARAM_SATURATION: return parameters.saturation;
+        case SPLUTTER_PARAM_DRIVE: return parameters.drive;
+        case SPLUTTER_PARAM_DELAY_CHANGE: return parameters.delay_change;
+        case SPLUTTER_PARAM_GLIDE_TIME: return parameters.glide_time;
+        case SPLUTTER_PARAM_GLIDE_CURVE: return parameters.glide_curve;
+        case SPLUTTER_PARAM_KEY_MODE: return parameters.key_mode;
+        case SPLUTTER_PARAM_ROOT_NOTE: return parameters.root_note;
+        default: return 0;
+    }
+}
+
+void splutter_set_eq_band(splutter* s, int band, float freq, float gain, float q)
+{
+    if (band < 0 || band >= NUM_EQ_BANDS || freq != freq || gain != gain || q != q) {
+        return;
+    }
+    EngineParameters& parameters = s->engine.parameters;
+    parameters.eq_freq[band] = clampTo(freq, 20.0f, 20000.0f);
+    parameters.eq_gain[band] = clampTo(gain, -18.0f, 18.0f);
+    parameters.eq_q[band] = clampTo(q, 0.1f, 10.0f);
+}
+
+void splutter_set_transport(splutter* s, double bpm, double ppq, int playing)
+{
+    s->engine.setTransport(bpm, ppq, playing != 0);
+}
+
+void splutter_switch_program(splutter* s)
+{
+    s->engine.switchProgram();
+}
+
+void splutter_key_event(splutter* s, int sample_offset, int note, int down)
+{
+    s->engine.addKeyEvent(sample_offset, note < 0 ? all_keys : note, down != 0);
+}
+
+void splutter_set_drawn_trajectory(splutter* s, const float* points, int num_points)
+{
+    s->engine.setDrawnTrajectory(points, num_points);
+}
+
+void splutter_process(splutter* s, float** channels, int num_channels, int nframes)
+{
+    if (nframes > 0 && num_channels > 0) {
+        s->engine.process(channels, num_channels, nframes);
+    }
+}
+
+void splutter_process_double(splutter* s, double** channels, int num_channels, int nframes)
+{
+    if (nframes > 0 && num_channels > 0) {
+        s->engine.process(channels, num_channels, nframes);
+    }
+}
+
+void splutter_process_bypassed(splutter* s, float** channels, int num_channels, int nframes)
+{
+    if (nframes > 0 && num_channels > 0) {
+        s->engine.processBypassed(channels, num_channels, nframes);
+    }
+}
+
+int splutter_get_latency(const splutter* s)
+{
+    return s->engine.getLatencySamples();
+}
@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    splutter.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// C interface to the pitch delay, for hosts other than the plugin: offline
+// renderers, test harnesses, other languages. It runs the same engine as the
+// plugin (SplutterEngine.h), without JUCE.
+//
+//     splutter* s = splutter_create(48000);
+//     splutter_set_param(s, SPLUTTER_PARAM_PITCH_SHIFT, 7);
+//     splutter_process(s, channels, 2, nframes);   // in place
+//     splutter_destroy(s);
+//
+// Parameters are in the units the plugin shows (seconds, semitones, Hz, dB),
+// and are clamped to the plugin's ranges. Choices take their index. They are
+// picked up at the start of the next process call, and ramp from there like
+// host automation. One instance must only be used by one thread at a time:
+// call the setters between process calls, not during them.
+
+#ifdef _WIN32
+ #define SPLUTTER_EXPORT __declspec(dllexport)
+#else
+ #define SPLUTTER_EXPORT __attribute__((visibility ("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPLUTTER_API_VERSION 5 // 2 added splutter_reset, 3 the delay change params, 4 keys,
+                                // 5 splutter_reset reports failure
+
+typedef struct splutter splutter;
+
+typedef enum {
+    SPLUTTER_PARAM_FEEDBACK = 0,     // 0 to 0.95
+    SPLUTTER_PARAM_DRY_WET,          // 0 to 1
+    SPLUTTER_PARAM_PITCH_SHIFT,      // semitones, -36 to 36
+    SPLUTTER_PARAM_RATE,             // grain length, 0.025 to 4 seconds
+    SPLUTTER_PARAM_MIN_DELAY,        // 0 to 4 seconds
+    SPLUTTER_PARAM_LO_CUT,           // 10 to 2000 Hz
+    SPLUTTER_PARAM_HI_CUT,           // 200 to 20000 Hz
+    SPLUTTER_PARAM_EQ_PLACEMENT,     // pre-delay, feedback, post
+    SPLUTTER_PARAM_RATE_SYNC,        // 0 for free running, or a note value up to 12
+    SPLUTTER_PARAM_DELAY_SYNC,
+    SPLUTTER_PARAM_ENGINE,           // sawtooth, overlap-add, spectral, trajectory
+    SPLUTTER_PARAM_OVERLAP,          // 2 to 4 heads
+    SPLUTTER_PARAM_SHAPE,            // sawtooth, triangle, stepped, random walk, drawn
+    SPLUTTER_PARAM_STEREO_FEEDBACK,  // normal, ping-pong, mid/side, width
+    SPLUTTER_PARAM_FEEDBACK_WIDTH,   // 0 to 2
+    SPLUTTER_PARAM_SATURATION,       // off, first-order, second-order
+    SPLUTTER_PARAM_DRIVE,            // 0 to 24 dB
+    SPLUTTER_PARAM_DELAY_CHANGE,     // glide, jump
+    SPLUTTER_PARAM_GLIDE_TIME,       // 0.01 to 4 seconds
+    SPLUTTER_PARAM_GLIDE_CURVE,      // linear, ease, exponential
+    SPLUTTER_PARAM_KEY_MODE,         // off, next grain, immediate
+    SPLUTTER_PARAM_ROOT_NOTE,        // MIDI note 0 to 127
+    SPLUTTER_NUM_PARAMS
+} splutter_param;
+
+#define SPLUTTER_NUM_EQ_BANDS 4
+#define SPLUTTER_MAX_CHANNELS 2
+
+SPLUTTER_EXPORT int splutter_get_api_version(void);
+
+// Allocates the delay history, so keep it off the audio thread, like
+// splutter_destroy. Returns null if sample_rate isn't positive or the
+// history can't be allocated.
+SPLUTTER_EXPORT splutter* splutter_create(double sample_rate);
+SPLUTTER_EXPORT void splutter_destroy(splutter* s);
+// Back to how splutter_create left it, at a new sample rate: default
+// parameters, 120 bpm and silence. The delay history goes back to the pool
+// and comes out again, so a kept instance can be reused without allocating,
+// but this isn't for the audio thread either. Returns 0 if sample_rate isn't
+// positive or the history can't be had at the new size, and 1 otherwise.
+// After a failed allocation, processing leaves the audio as it is until a
+// reset succeeds.
+SPLUTTER_EXPORT int splutter_reset(splutter* s, double sample_rate);
+
+// Unknown parameters are ignored, and read as 0.
+SPLUTTER_EXPORT void splutter_set_param(splutter* s, splutter_param param, float value);
+SPLUTTER_EXPORT float splutter_get_param(const splutter* s, splutter_param param);
+// Band 0 is a low shelf, 1 and 2 are peaks and 3 is a high shelf.
+// freq 20 to 20000 Hz, gain -18 to 18 dB, q 0.1 to 10.
+SPLUTTER_EXPORT void splutter_set_eq_band(splutter* s, int band, float freq, float gain, float q);
+
+// For the tempo synced rate and delay. Without it the tempo is 120 bpm and
+// the grains run free. ppq is the position at the start of the next block.
+SPLUTTER_EXPORT void splutter_set_transport(splutter* s, double bpm, double ppq, int playing);
+// Jumps to the current parameters with a short crossfade, like switching
+// programs, instead of ramping and gliding over to them.
+SPLUTTER_EXPORT void splutter_switch_program(splutter* s);
+// A MIDI key going down or up sample_offset frames into the next process
+// call, for playing the pitch shift with SPLUTTER_PARAM_KEY_MODE on. Add a
+// block's keys in order. A note of -1 lets every key go.
+SPLUTTER_EXPORT void splutter_key_event(splutter* s, int sample_offset, int note, int down);
+// The drawn trajectory: num_points values from 0 to 1 across one grain,
+// at most 64. Unlike the other setters, this one can be called from
+// another thread while processing.
+SPLUTTER_EXPORT void splutter_set_drawn_trajectory(splutter* s, const float* points, int num_points);
+
+// Processes num_channels channels of nframes samples in place. Only the
+// first SPLUTTER_MAX_CHANNELS are touched; mono runs the left channel.
+SPLUTTER_EXPORT void splutter_process(splutter* s, float** channels, int num_channels, int nframes);
+SPLUTTER_EXPORT void splutter_process_double(splutter* s, double** channels, int num_channels, int nframes);
+// Passes the input through while the delay history keeps filling, fading
+// out of and back into the effect.
+SPLUTTER_EXPORT void splutter_process_bypassed(splutter* s, float** channels, int num_channels, int nframes);
+
+// Samples of latency the output currently has (the spectral engine's).
+SPLUTTER_EXPORT int splutter_get_latency(const splutter* s);
+
+#ifdef __cplusplus
+}
+#endif
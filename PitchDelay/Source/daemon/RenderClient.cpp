@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+    RenderClient.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "RenderClient.h"
+
+#if defined (__linux__)
+
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace render_protocol;
+
+RenderClient::RenderClient(): socket_fd(-1), ring(nullptr), ring_bytes(0), num_slots(0), slot_floats(0), next_job_id(0)
+{
+}
+
+RenderClient::~RenderClient()
+{
+    disconnect();
+}
+
+bool RenderClient::connect(const char* socketPath, int numSlots, size_t slotFloats)
+{
+    disconnect();
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (numSlots <= 0 || slotFloats == 0 || std::strlen(socketPath) >= sizeof(address.sun_path)) {
+        errno = EINVAL;
+        return false;
+    }
+    std::strcpy(address.sun_path, socketPath);
+
+    socket_fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (socket_fd < 0 || ::connect(socket_fd, (sockaddr*) &address, sizeof(address)) != 0) {
+        disconnect();
+        return false;
+    }
+
+    // The ring is a memfd rather than a file or POSIX shm name, so nothing
+    // is left behind in the filesystem, and it goes when both sides unmap it.
+    // It is sealed against shrinking, which the daemon insists on, as a
+    // shrunk ring would fault it the next time it touched the lost pages.
+    const size_t bytes = (size_t) numSlots * slotFloats * sizeof(float);
+    int memfd = memfd_create("splutter-ring", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (memfd < 0) {
+        disconnect();
+        return false;
+    }
+    void* mapped = MAP_FAILED;
+    if (ftruncate(memfd, (off_t) bytes) == 0 && fcntl(memfd, F_ADD_SEALS, F_SEAL_SHRINK) == 0) {
+        mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+    }
+    if (mapped == MAP_FAILED) {
+        close(memfd);
+        disconnect();
+        return false;
+    }
+    ring = static_cast<float*>(mapped);
+    ring_bytes = bytes;
+    num_slots = numSlots;
+    slot_floats = slotFloats;
+
+    RingSetup setup = { message_ring_setup, version, (uint32_t) numSlots, (uint32_t) slotFloats };
+    iovec io = { &setup, sizeof(setup) };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    std::memset(control, 0, sizeof(control));
+    msghdr header;
+    std::memset(&header, 0, sizeof(header));
+    header.msg_iov = &io;
+    header.msg_iovlen = 1;
+    header.msg_control = control;
+    header.msg_controllen = sizeof(control);
+    cmsghdr* part = CMSG_FIRSTHDR(&header);
+    part->cmsg_level = SOL_SOCKET;
+    part->cmsg_type = SCM_RIGHTS;
+    part->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(part), &memfd, sizeof(int));
+
+    const bool sent = sendmsg(socket_fd, &header, MSG_NOSIGNAL) == (ssize_t) sizeof(setup);
+    close(memfd); // both mappings keep the memory
+    if (! sent) {
+        disconnect();
+        return false;
+    }
+    return true;
+}
+
+void RenderClient::disconnect()
+{
+    if (ring != nullptr) {
+        munmap(ring, ring_bytes);
+        ring = nullptr;
+    }
+    if (socket_fd >= 0) {
+        close(socket_fd);
+        socket_fd = -1;
+    }
+    ring_bytes = 0;
+    num_slots = 0;
+    slot_floats = 0;
+}
+
+JobRequest RenderClient::newJob(double sampleRate, int numChannels, int numFrames)
+{
+    JobRequest job;
+    std::memset(&job, 0, sizeof(job));
+    job.type = message_job;
+    job.num_channels = (uint32_t) numChannels;
+    job.num_frames = (uint32_t) numFrames;
+    job.sample_rate = sampleRate;
+    return job;
+}
+
+void RenderClient::setParam(JobRequest& job, splutter_param param, float value)
+{
+    if (param >= 0 && param < SPLUTTER_NUM_PARAMS) {
+        job.params[param] = value;
+        job.param_mask |= 1u << param;
+    }
+}
+
+void RenderClient::setEqBand(JobRequest& job, int band, float freq, float gain, float q)
+{
+    if (band >= 0 && band < SPLUTTER_NUM_EQ_BANDS) {
+        job.eq[band][0] = freq;
+        job.eq[band][1] = gain;
+        job.eq[band][2] = q;
+        job.eq_mask |= 1u << band;
+    }
+}
+
+long RenderClient::submit(JobRequest& job, int slot)
+{
+    job.type = message_job;
+    job.job_id = next_job_id++;
+    job.slot = (uint32_t) slot;
+    if (send(socket_fd, &job, sizeof(job), MSG_NOSIGNAL) != (ssize_t) sizeof(job)) {
+        return -1;
+    }
+    return job.job_id;
+}
+
+bool RenderClient::waitForReply(JobReply& reply)
+{
+    for (;;) {
+        const ssize_t size = recv(socket_fd, &reply, sizeof(reply), 0);
+        if (size == (ssize_t) sizeof(reply) && reply.type == message_job_reply) {
+            return true;
+        }
+        if (size < 0 && errno == EINTR) {
+            continue;
+        }
+        return false;
+    }
+}
+
+#endif
@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    RenderClient.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "RenderProtocol.h"
+#include <stddef.h>
+
+// The client side of splutterd: makes the ring, hands it to the daemon and
+// sends jobs on it. Linux only, like the daemon.
+//
+//     RenderClient client;
+//     client.connect(render_protocol::default_socket_path, 4, 2 * 48000 * 10);
+//     render_protocol::JobRequest job = RenderClient::newJob(48000, 2, frames);
+//     RenderClient::setParam(job, SPLUTTER_PARAM_PITCH_SHIFT, 7);
+//     // write the clip into client.getSlot(0), left then right
+//     client.submit(job, 0);
+//     render_protocol::JobReply reply;
+//     client.waitForReply(reply); // client.getSlot(reply.slot) now holds the result
+//
+// Don't touch a slot between submitting it and getting its reply.
+class RenderClient
+{
+public:
+    RenderClient();
+    ~RenderClient();
+
+    // Connects, and makes and sends a ring of numSlots slots of slotFloats
+    // floats each. False, with errno set, if any of it fails.
+    bool connect(const char* socketPath, int numSlots, size_t slotFloats);
+    void disconnect();
+
+    float* getSlot(int slot) const { return ring + (size_t) slot * slot_floats; }
+    int getNumSlots() const { return num_slots; }
+    size_t getSlotFloats() const { return slot_floats; }
+
+    // A job at default parameters.
+    static render_protocol::JobRequest newJob(double sampleRate, int numChannels, int numFrames);
+    static void setParam(render_protocol::JobRequest& job, splutter_param param, float value);
+    static void setEqBand(render_protocol::JobRequest& job, int band, float freq, float gain, float q);
+
+    // Sends job on slot, giving it the next job id, which it returns; -1 if
+    // the send failed.
+    long submit(render_protocol::JobRequest& job, int slot);
+    // Blocks until a reply comes. False if the daemon has gone.
+    bool waitForReply(render_protocol::JobReply& reply);
+
+private:
+    int socket_fd;
+    float* ring;
+    size_t ring_bytes;
+    int num_slots;
+    size_t slot_floats;
+    uint32_t next_job_id;
+
+    RenderClient(const RenderClient&) = delete;
+    RenderClient& operator=(const RenderClient&) = delete;
+};
@@ -0,0 +1,439 @@
+/*
+  ==============================================================================
+
+    RenderDaemon.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "RenderDaemon.h"
+
+#if defined (__linux__)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace render_protocol;
+
+static uint64_t nowNs()
+{
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool makeAddress(const std::string& path, sockaddr_un& address)
+{
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+    return true;
+}
+
+//==============================================================================
+RenderDaemon::Session::~Session()
+{
+    if (ring != nullptr) {
+        munmap(ring, ring_bytes);
+    }
+    close(socket);
+}
+
+//==============================================================================
+RenderDaemon::RenderDaemon(const DaemonSettings& daemonSettings): settings(daemonSettings), listen_socket(-1), running(false)
+{
+    wake_pipe[0] = -1;
+    wake_pipe[1] = -1;
+    std::memset(&stats, 0, sizeof(stats));
+}
+
+RenderDaemon::~RenderDaemon()
+{
+    running = false;
+    shutDown();
+    sessions.clear();
+    for (splutter* engine : engines) {
+        splutter_destroy(engine);
+    }
+    if (listen_socket >= 0) {
+        close(listen_socket);
+        unlink(settings.socket_path.c_str());
+    }
+    for (int fd : wake_pipe) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+bool RenderDaemon::start()
+{
+    sockaddr_un address;
+    if (! makeAddress(settings.socket_path, address)) {
+        std::fprintf(stderr, "splutterd: bad socket path '%s'\n", settings.socket_path.c_str());
+        return false;
+    }
+    if (settings.num_workers < 1 || settings.block_size < 1 || ! (settings.warm_sample_rate > 0)) {
+        std::fprintf(stderr, "splutterd: needs at least one worker, a block size and a sample rate\n");
+        return false;
+    }
+
+    listen_socket = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (listen_socket < 0) {
+        std::perror("splutterd: socket");
+        return false;
+    }
+    // A socket file nobody answers on is left over from a daemon that
+    // didn't shut down cleanly; one that answers is a daemon still running.
+    int probe = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (probe >= 0) {
+        const bool taken = connect(probe, (sockaddr*) &address, sizeof(address)) == 0;
+        close(probe);
+        if (taken) {
+            std::fprintf(stderr, "splutterd: another daemon is serving %s\n", settings.socket_path.c_str());
+            return false;
+        }
+    }
+    unlink(settings.socket_path.c_str());
+    if (bind(listen_socket, (sockaddr*) &address, sizeof(address)) != 0 || listen(listen_socket, 64) != 0) {
+        std::perror("splutterd: bind");
+        return false;
+    }
+    // Only this user's processes get to send jobs.
+    chmod(settings.socket_path.c_str(), 0600);
+
+    if (pipe2(wake_pipe, O_CLOEXEC | O_NONBLOCK) != 0) {
+        std::perror("splutterd: pipe");
+        return false;
+    }
+
+    // Warm the pool: every engine is made and prepared now, so that its
+    // tables are built and the history pool holds blocks of the right size
+    // before the first job comes in.
+    for (int i = 0; i < settings.num_workers; ++i) {
+        splutter* engine = splutter_create(settings.warm_sample_rate);
+        if (engine == nullptr) {
+            std::fprintf(stderr, "splutterd: could not create an engine\n");
+            return false;
+        }
+        engines.push_back(engine);
+    }
+    running = true;
+    for (splutter* engine : engines) {
+        workers.emplace_back(&RenderDaemon::runWorker, this, engine);
+    }
+    return true;
+}
+
+void RenderDaemon::run()
+{
+    std::vector<pollfd> fds;
+    while (running) {
+        fds.clear();
+        fds.push_back({ listen_socket, POLLIN, 0 });
+        fds.push_back({ wake_pipe[0], POLLIN, 0 });
+        for (const std::shared_ptr<Session>& session : sessions) {
+            fds.push_back({ session->socket, POLLIN, 0 });
+        }
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::perror("splutterd: poll");
+            break;
+        }
+        if (! running) {
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            acceptClient();
+        }
+        // Back to front, so removing a session doesn't move the ones still
+        // to be looked at.
+        for (size_t i = fds.size() - 1; i >= 2; --i) {
+            if (fds[i].revents == 0) {
+                continue;
+            }
+            std::shared_ptr<Session>& session = sessions[i - 2];
+            if (! readMessage(session)) {
+                sessions.erase(sessions.begin() + (i - 2));
+            }
+        }
+    }
+    running = false;
+    shutDown();
+}
+
+void RenderDaemon::stop()
+{
+    // Safe from a signal handler: an atomic store and a write.
+    running = false;
+    if (wake_pipe[1] >= 0) {
+        const char wake = 1;
+        ssize_t written = write(wake_pipe[1], &wake, 1);
+        (void) written;
+    }
+}
+
+void RenderDaemon::shutDown()
+{
+    {
+        std::lock_guard<std::mutex> lock(queue_lock);
+        queue_ready.notify_all();
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    for (const Job& job : queue) {
+        JobReply answer;
+        std::memset(&answer, 0, sizeof(answer));
+        answer.type = message_job_reply;
+        answer.job_id = job.request.job_id;
+        answer.slot = job.request.slot;
+        answer.status = status_shutting_down;
+        reply(*job.session, answer);
+    }
+    queue.clear();
+}
+
+DaemonStats RenderDaemon::getStats() const
+{
+    std::lock_guard<std::mutex> lock(stats_lock);
+    return stats;
+}
+
+//==============================================================================
+void RenderDaemon::acceptClient()
+{
+    int fd = accept4(listen_socket, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd >= 0) {
+        sessions.push_back(std::make_shared<Session>(fd));
+    }
+}
+
+bool RenderDaemon::readMessage(const std::shared_ptr<Session>& session)
+{
+    JobRequest message; // the largest message
+    iovec io = { &message, sizeof(message) };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    msghdr header;
+    std::memset(&header, 0, sizeof(header));
+    header.msg_iov = &io;
+    header.msg_iovlen = 1;
+    header.msg_control = control;
+    header.msg_controllen = sizeof(control);
+
+    const ssize_t size = recvmsg(session->socket, &header, MSG_CMSG_CLOEXEC);
+    if (size < 0) {
+        return errno == EINTR || errno == EAGAIN;
+    }
+    if (size == 0) {
+        return false; // hung up
+    }
+
+    int memfd = -1;
+    for (cmsghdr* part = CMSG_FIRSTHDR(&header); part != nullptr; part = CMSG_NXTHDR(&header, part)) {
+        if (part->cmsg_level == SOL_SOCKET && part->cmsg_type == SCM_RIGHTS) {
+            std::memcpy(&memfd, CMSG_DATA(part), sizeof(int));
+        }
+    }
+
+    bool ok = false;
+    if (size == sizeof(RingSetup) && message.type == message_ring_setup && memfd >= 0) {
+        RingSetup setup;
+        std::memcpy(&setup, &message, sizeof(setup));
+        ok = setUpRing(*session, setup, memfd);
+    } else if (size == sizeof(JobRequest) && message.type == message_job && (header.msg_flags & MSG_TRUNC) == 0) {
+        queueJob(session, message);
+        ok = true;
+    } else {
+        std::fprintf(stderr, "splutterd: dropping a client that sent a message it shouldn't have\n");
+    }
+    if (memfd >= 0) {
+        close(memfd); // the mapping keeps the memory
+    }
+    return ok;
+}
+
+bool RenderDaemon::setUpRing(Session& session, const RingSetup& setup, int memfd)
+{
+    const uint64_t bytes = (uint64_t) setup.num_slots * setup.slot_floats * sizeof(float);
+    struct stat file;
+    // Without the seal, the client could shrink the memfd under the mapping
+    // and the next job would take the daemon down with SIGBUS.
+    const int seals = fcntl(memfd, F_GET_SEALS);
+    if (setup.version != version || session.ring != nullptr || bytes == 0 || bytes > SIZE_MAX
+        || seals < 0 || (seals & F_SEAL_SHRINK) == 0
+        || fstat(memfd, &file) != 0 || (uint64_t) file.st_size < bytes) {
+        std::fprintf(stderr, "splutterd: dropping a client with a bad ring\n");
+        return false;
+    }
+    void* mapped = mmap(nullptr, (size_t) bytes, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+    if (mapped == MAP_FAILED) {
+        std::perror("splutterd: mmap");
+        return false;
+    }
+    session.ring = static_cast<float*>(mapped);
+    session.ring_bytes = (size_t) bytes;
+    session.num_slots = setup.num_slots;
+    session.slot_floats = setup.slot_floats;
+    return true;
+}
+
+void RenderDaemon::queueJob(const std::shared_ptr<Session>& session, const JobRequest& request)
+{
+    int32_t status = status_ok;
+    if (session->ring == nullptr) {
+        status = status_no_ring;
+    } else if (request.slot >= session->num_slots) {
+        status = status_bad_slot;
+    } else if (request.num_channels == 0 || request.num_channels > SPLUTTER_MAX_CHANNELS
+               || request.num_frames == 0 || ! (request.sample_rate > 0)) {
+        status = status_bad_format;
+    } else if ((uint64_t) request.num_channels * request.num_frames > session->slot_floats) {
+        status = status_too_long;
+    } else if (session->in_flight >= session->num_slots) {
+        status = status_busy;
+    }
+    if (status != status_ok) {
+        JobReply answer;
+        std::memset(&answer, 0, sizeof(answer));
+        answer.type = message_job_reply;
+        answer.job_id = request.job_id;
+        answer.slot = request.slot;
+        answer.status = status;
+        reply(*session, answer);
+        recordJob(answer);
+        return;
+    }
+
+    ++session->in_flight;
+    std::lock_guard<std::mutex> lock(queue_lock);
+    queue.push_back({ session, request, nowNs() });
+    queue_ready.notify_one();
+}
+
+//==============================================================================
+void RenderDaemon::runWorker(splutter* engine)
+{
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(queue_lock);
+            queue_ready.wait(lock, [this] { return ! queue.empty() || ! running; });
+            if (! running) {
+                return;
+            }
+            job = queue.front();
+            queue.pop_front();
+        }
+        // Nobody is reading the result of a cut-off client's jobs.
+        if (job.session->dead) {
+            --job.session->in_flight;
+            continue;
+        }
+
+        JobReply answer;
+        std::memset(&answer, 0, sizeof(answer));
+        answer.type = message_job_reply;
+        answer.job_id = job.request.job_id;
+        answer.slot = job.request.slot;
+        const uint64_t started = nowNs();
+        answer.status = renderJob(engine, job, answer.latency_samples);
+        const uint64_t finished = nowNs();
+        answer.queue_ns = started - job.received_ns;
+        answer.render_ns = finished - started;
+        // Before the reply, so a client that sends its next job as soon as
+        // the reply comes in finds the slot free.
+        --job.session->in_flight;
+        reply(*job.session, answer);
+        recordJob(answer);
+    }
+}
+
+int32_t RenderDaemon::renderJob(splutter* engine, const Job& job, int32_t& latencySamples)
+{
+    const JobRequest& request = job.request;
+    if (! splutter_reset(engine, request.sample_rate)) {
+        return status_out_of_memory;
+    }
+    if (request.bpm > 0) {
+        splutter_set_transport(engine, request.bpm, 0.0, 0);
+    }
+    for (int param = 0; param < SPLUTTER_NUM_PARAMS; ++param) {
+        if (request.param_mask & (1u << param)) {
+            splutter_set_param(engine, (splutter_param) param, request.params[param]);
+        }
+    }
+    for (int band = 0; band < SPLUTTER_NUM_EQ_BANDS; ++band) {
+        if (request.eq_mask & (1u << band)) {
+            splutter_set_eq_band(engine, band, request.eq[band][0], request.eq[band][1], request.eq[band][2]);
+        }
+    }
+
+    // queueJob has already turned away jobs wider than SPLUTTER_MAX_CHANNELS.
+    float* slot = job.session->ring + (size_t) request.slot * job.session->slot_floats;
+    const int num_channels = (int) request.num_channels;
+    const int num_frames = (int) request.num_frames;
+    float* channels[SPLUTTER_MAX_CHANNELS];
+    for (int start = 0; start < num_frames; start += settings.block_size) {
+        const int length = std::min(settings.block_size, num_frames - start);
+        for (int channel = 0; channel < num_channels; ++channel) {
+            channels[channel] = slot + (size_t) channel * num_frames + start;
+        }
+        splutter_process(engine, channels, num_channels, length);
+    }
+    latencySamples = splutter_get_latency(engine);
+    return status_ok;
+}
+
+void RenderDaemon::reply(Session& session, const JobReply& answer)
+{
+    // A client that has gone, or has filled its socket by not reading its
+    // replies, would otherwise hold up a worker, and then every client and
+    // the shutdown with it. Shutting the socket down wakes run, which drops
+    // the session, and the workers skip whatever it still has queued.
+    if (session.dead) {
+        return;
+    }
+    if (send(session.socket, &answer, sizeof(answer), MSG_NOSIGNAL | MSG_DONTWAIT) != (ssize_t) sizeof(answer)) {
+        session.dead = true;
+        shutdown(session.socket, SHUT_RDWR);
+    }
+}
+
+void RenderDaemon::recordJob(const JobReply& answer)
+{
+    {
+        std::lock_guard<std::mutex> lock(stats_lock);
+        if (answer.status == status_ok) {
+            ++stats.jobs;
+            stats.total_queue_ns += answer.queue_ns;
+            stats.total_render_ns += answer.render_ns;
+            stats.max_latency_ns = std::max(stats.max_latency_ns, answer.queue_ns + answer.render_ns);
+        } else {
+            ++stats.failed_jobs;
+        }
+    }
+    if (settings.log_jobs) {
+        std::fprintf(stderr, "splutterd: job %u slot %u: status %d, queued %.3f ms, rendered %.3f ms\n",
+                     answer.job_id, answer.slot, answer.status, answer.queue_ns * 1e-6, answer.render_ns * 1e-6);
+    }
+}
+
+#endif
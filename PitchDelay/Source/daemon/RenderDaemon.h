@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    RenderDaemon.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "RenderProtocol.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct DaemonSettings {
+    std::string socket_path;
+    int num_workers;          // engines in the warm pool, one per worker thread
+    double warm_sample_rate;  // what the pool is prepared at before any job
+    int block_size;           // jobs are processed in blocks of this many frames, like a host
+    bool log_jobs;            // a line per job on stderr
+
+    DaemonSettings(): socket_path(render_protocol::default_socket_path), num_workers(1),
+                      warm_sample_rate(48000), block_size(512), log_jobs(false) {}
+};
+
+struct DaemonStats {
+    long jobs;
+    long failed_jobs;
+    uint64_t total_queue_ns;
+    uint64_t total_render_ns;
+    uint64_t max_latency_ns;  // queue and render together
+};
+
+// Renders jobs from local clients without starting a process per job. The
+// engines are made and prepared once, when the daemon starts, and every job
+// resets one of them (splutter_reset) instead of creating one, so a job
+// costs the render and a pooled history block, not a process start and an
+// allocation. Linux only: it needs SOCK_SEQPACKET, memfd mappings and
+// SCM_RIGHTS.
+//
+// One thread polls the listening socket and the clients and queues their
+// jobs; the workers take them off the queue, each with its own engine, and
+// reply to the client directly. Nothing leaves the machine.
+class RenderDaemon
+{
+public:
+    explicit RenderDaemon(const DaemonSettings& settings);
+    ~RenderDaemon();
+
+    // Binds the socket, replacing a stale one, and starts the workers.
+    // False, with the reason on stderr, if either fails.
+    bool start();
+    // Serves until stop is called, from a signal handler or another thread.
+    void run();
+    void stop();
+
+    DaemonStats getStats() const;
+
+private:
+    // A connected client and the ring it sent. Jobs hold on to their
+    // session, so the ring stays mapped until its last job is done, even
+    // if the client has gone. A client gets at most num_slots jobs in
+    // flight, and is cut off, with dead set, once it stops reading its
+    // replies.
+    struct Session {
+        int socket;
+        float* ring;
+        size_t ring_bytes;
+        uint32_t num_slots;
+        uint32_t slot_floats;
+        std::atomic<uint32_t> in_flight;
+        std::atomic<bool> dead;
+
+        Session(int fd): socket(fd), ring(nullptr), ring_bytes(0), num_slots(0), slot_floats(0), in_flight(0), dead(false) {}
+        ~Session();
+    };
+
+    struct Job {
+        std::shared_ptr<Session> session;
+        render_protocol::JobRequest request;
+        uint64_t received_ns;
+    };
+
+    DaemonSettings settings;
+    int listen_socket;
+    int wake_pipe[2]; // stop writes to it to break the poll
+    std::atomic<bool> running;
+
+    std::vector<std::shared_ptr<Session>> sessions;
+    std::vector<splutter*> engines; // the warm pool, one per worker
+    std::vector<std::thread> workers;
+
+    std::mutex queue_lock;
+    std::condition_variable queue_ready;
+    std::deque<Job> queue;
+
+    mutable std::mutex stats_lock;
+    DaemonStats stats;
+
+    void acceptClient();
+    // False when the client has hung up or broken the protocol.
+    bool readMessage(const std::shared_ptr<Session>& session);
+    bool setUpRing(Session& session, const render_protocol::RingSetup& setup, int memfd);
+    void queueJob(const std::shared_ptr<Session>& session, const render_protocol::JobRequest& request);
+
+    // Answers whatever is still queued and waits for the workers.
+    void shutDown();
+
+    void runWorker(splutter* engine);
+    int32_t renderJob(splutter* engine, const Job& job, int32_t& latencySamples);
+    // Never waits for the client: one whose socket is full is cut off.
+    void reply(Session& session, const render_protocol::JobReply& reply);
+    void recordJob(const render_protocol::JobReply& reply);
+
+    RenderDaemon(const RenderDaemon&) = delete;
+    RenderDaemon& operator=(const RenderDaemon&) = delete;
+};
@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    RenderProtocol.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../core/splutter.h"
+#include <stdint.h>
+
+// The messages between splutterd and its clients, over a SOCK_SEQPACKET Unix
+// domain socket, so each send is one whole message. Only these small structs
+// go through the socket; the audio stays in a ring of slots in a memfd that
+// the client makes and both sides map.
+//
+//     client: socket, connect, send RingSetup with the memfd attached,
+//             sealed with F_SEAL_SHRINK
+//     client: fill slot i, send JobRequest { slot = i }
+//     daemon: process slot i in place, send JobReply
+//     client: read slot i back once the reply for it arrives
+//
+// A client can have a job in flight for every slot. Replies come back in
+// the order the jobs finish, which with several workers isn't always the
+// order they were sent, so match them up by job_id.
+namespace render_protocol {
+    const uint32_t version = 4; // 2 added the delay change params, 3 the key params, 4 sealed rings
+
+    enum MessageType : uint32_t {
+        message_ring_setup = 1,
+        message_job,
+        message_job_reply,
+    };
+
+    enum JobStatus : int32_t {
+        status_ok = 0,
+        status_no_ring = -1,      // no RingSetup yet, or it failed
+        status_bad_slot = -2,     // the slot isn't in the ring
+        status_too_long = -3,     // channels * frames doesn't fit a slot
+        status_bad_format = -4,   // no channels, too many, or no frames
+        status_shutting_down = -5,
+        status_out_of_memory = -6, // the engine couldn't get its delay history
+        status_busy = -7,         // already a job in flight for every slot
+    };
+
+    // One slot holds the job's channels one after the other: channel c
+    // starts at float c * num_frames of the slot.
+    struct RingSetup {
+        uint32_t type;        // message_ring_setup
+        uint32_t version;
+        uint32_t num_slots;
+        uint32_t slot_floats; // the memfd is at least num_slots * slot_floats floats
+    };
+
+    // Each job starts a pooled engine from silence at default parameters,
+    // then sets the parameters whose bits are in param_mask (bit n for
+    // splutter_param n) and the EQ bands whose bits are in eq_mask.
+    struct JobRequest {
+        uint32_t type;        // message_job
+        uint32_t job_id;      // handed back in the reply
+        uint32_t slot;
+        uint32_t num_channels;
+        uint32_t num_frames;
+        uint32_t param_mask;
+        uint32_t eq_mask;
+        uint32_t reserved;
+        double sample_rate;
+        double bpm;           // 0 for the default 120
+        float params[SPLUTTER_NUM_PARAMS];
+        float eq[SPLUTTER_NUM_EQ_BANDS][3]; // freq, gain, q
+    };
+
+    // queue_ns is from the daemon reading the request to a worker taking it
+    // up; render_ns is from there to the slot being done.
+    struct JobReply {
+        uint32_t type;        // message_job_reply
+        uint32_t job_id;
+        uint32_t slot;
+        int32_t status;       // JobStatus
+        int32_t latency_samples;
+        uint32_t reserved;
+        uint64_t queue_ns;
+        uint64_t render_ns;
+    };
+
+    // Where clients find the daemon when neither side is told otherwise.
+    const char* const default_socket_path = "/tmp/splutterd.sock";
+}
@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    splutterd.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+// splutterd [-s socket] [-w workers] [-r warm sample rate] [-b block size] [-v]
+//
+// Serves render jobs until SIGINT or SIGTERM, then prints how many it did and
+// how long they took. The main function is only compiled with
+// SPLUTTER_DAEMON=1, so a build that takes in every source file, like the
+// plugin's, doesn't get a second one.
+
+#include "RenderDaemon.h"
+
+#if defined (__linux__) && SPLUTTER_DAEMON
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static RenderDaemon* running_daemon = nullptr;
+
+static void onSignal(int)
+{
+    if (running_daemon != nullptr) {
+        running_daemon->stop();
+    }
+}
+
+static void printUsage()
+{
+    std::fprintf(stderr, "usage: splutterd [-s socket] [-w workers] [-r warm sample rate] [-b block size] [-v]\n");
+}
+
+int main(int argc, char** argv)
+{
+    DaemonSettings settings;
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "-s") == 0 && has_value) {
+            settings.socket_path = argv[++i];
+        } else if (std::strcmp(argv[i], "-w") == 0 && has_value) {
+            settings.num_workers = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-r") == 0 && has_value) {
+            settings.warm_sample_rate = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "-b") == 0 && has_value) {
+            settings.block_size = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-v") == 0) {
+            settings.log_jobs = true;
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+
+    RenderDaemon daemon(settings);
+    if (! daemon.start()) {
+        return 1;
+    }
+    running_daemon = &daemon;
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = onSignal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    std::fprintf(stderr, "splutterd: serving %s with %d engines\n", settings.socket_path.c_str(), settings.num_workers);
+    daemon.run();
+    running_daemon = nullptr;
+
+    const DaemonStats stats = daemon.getStats();
+    const double jobs = stats.jobs > 0 ? (double) stats.jobs : 1.0;
+    std::fprintf(stderr, "splutterd: %ld jobs (%ld failed), mean queue %.3f ms, mean render %.3f ms, worst %.3f ms\n",
+                 stats.jobs, stats.failed_jobs, stats.total_queue_ns * 1e-6 / jobs,
+                 stats.total_render_ns * 1e-6 / jobs, stats.max_latency_ns * 1e-6);
+    return 0;
+}
+
+#endif
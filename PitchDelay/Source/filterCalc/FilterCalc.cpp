@@ -316,18 +316,103 @@ void FilterCalc::calcCoeffsBPF(float* coeffs, float fc, float Q, float fs)
     coeffs[4] = a2;
 }
 
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Calculates the coefficients of many bands in one call.
+// See FilterCalc.h for the argument layout.
+//
+// Every shape above can be written as
+//   b = [n0, n1, n2] / D,  a = [d1, d2] / D
+// where the peak and shelf numerator/denominator use a "numerator gain" Vn
+// and "denominator gain" Vd: (V, 1) when boosting and (1, V) when cutting.
+// That turns the gain sign into two selects instead of two code paths.
+
+void FilterCalc::calcCoeffsBands(float* coeffs, const int* types, const float* fc, const float* gainDb,
+                                 const float* Q, int count, float fs)
+{
+    const int chunk = 16;
+    float K[chunk], Vn[chunk], Vd[chunk], sqrtVn[chunk], sqrtVd[chunk];
+    
+    for (int start = 0; start < count; start += chunk) {
+        const int n = (count - start < chunk) ? count - start : chunk;
+        const float* f = fc + start;
+        const float* g = gainDb + start;
+        
+        // Transcendental terms for the whole chunk.
+        for (int i = 0; i < n; ++i) {
+            float limited = f[i] < 10 ? 10 : (f[i] > fs/2 ? fs/2 : f[i]);
+            K[i] = tanf(myPI*limited/fs);
+        }
+        for (int i = 0; i < n; ++i) {
+            float V = powf(10, fabsf(g[i])/20);
+            Vn[i] = g[i] >= 0 ? V : 1;
+            Vd[i] = g[i] >= 0 ? 1 : V;
+        }
+        for (int i = 0; i < n; ++i) {
+            sqrtVn[i] = sqrtf(2*Vn[i]);
+            sqrtVd[i] = sqrtf(2*Vd[i]);
+        }
+        
+        // Cheap per-band polynomials.
+        for (int i = 0; i < n; ++i) {
+            const float k = K[i], ksq = k*k, q = Q[start + i];
+            float n0, n1, n2, D, d1, d2;
+            switch (types[start + i]) {
+                case bandLowShelf:
+                    n0 = 1 + sqrtVn[i]*k + Vn[i]*ksq;
+                    n1 = 2*(Vn[i]*ksq - 1);
+                    n2 = 1 - sqrtVn[i]*k + Vn[i]*ksq;
+                    D  = 1 + sqrtVd[i]*k + Vd[i]*ksq;
+                    d1 = 2*(Vd[i]*ksq - 1);
+                    d2 = 1 - sqrtVd[i]*k + Vd[i]*ksq;
+                    break;
+                case bandHighShelf:
+                    n0 = Vn[i] + sqrtVn[i]*k + ksq;
+                    n1 = 2*(ksq - Vn[i]);
+                    n2 = Vn[i] - sqrtVn[i]*k + ksq;
+                    D  = Vd[i] + sqrtVd[i]*k + ksq;
+                    d1 = 2*(ksq - Vd[i]);
+                    d2 = Vd[i] - sqrtVd[i]*k + ksq;
+                    break;
+                case bandBPF:
+                    D  = ksq*q + k + q;
+                    n0 = k;
+                    n1 = 0;
+                    n2 = -k;
+                    d1 = 2*q*(ksq - 1);
+                    d2 = ksq*q - k + q;
+                    break;
+                case bandLPF:
+                    D  = ksq*q + k + q;
+                    n0 = ksq*q;
+                    n1 = 2*n0;
+                    n2 = n0;
+                    d1 = 2*q*(ksq - 1);
+                    d2 = ksq*q - k + q;
+                    break;
+                case bandHPF:
+                    D  = ksq*q + k + q;
+                    n0 = q;
+                    n1 = -2*q;
+                    n2 = q;
+                    d1 = 2*q*(ksq - 1);
+                    d2 = ksq*q - k + q;
+                    break;
+                case bandPeak:
+                default:
+                    n0 = 1 + Vn[i]*k/q + ksq;
+                    n1 = 2*(ksq - 1);
+                    n2 = 1 - Vn[i]*k/q + ksq;
+                    D  = 1 + Vd[i]*k/q + ksq;
+                    d1 = 2*(ksq - 1);
+                    d2 = 1 - Vd[i]*k/q + ksq;
+                    break;
+            }
+            float* c = coeffs + 5 * (start + i);
+            c[0] = n0 / D;
+            c[1] = n1 / D;
+            c[2] = n2 / D;
+            c[3] = d1 / D;
+            c[4] = d2 / D;
+        }
+    }
+}
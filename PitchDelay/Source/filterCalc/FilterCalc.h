@@ -67,6 +67,26 @@ public:
     // fs     = sampling rate in Hz
     static void calcCoeffsBPF(float* coeffs, float fc, float Q, float fs);
     
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    // Band shapes for calcCoeffsBands.
+    enum BandType { bandPeak = 0, bandLowShelf, bandHighShelf, bandBPF, bandLPF, bandHPF };
+    
+    // Calculates the coefficients of many bands in one call, e.g. every band
+    // of a multiband EQ for every channel. Each band gets the same
+    // coefficients as the single-band functions above, but the expensive
+    // tan/pow/sqrt terms are computed across all bands in flat loops the
+    // compiler can vectorize, and the boost/cut cases are selected without
+    // branching.
+    // coeffs = [b0, b1, b2, a1, a2] per band, 5 * count floats
+    // types  = one BandType per band
+    // fc     = center/transition frequency in Hz per band
+    // gainDb = gain per band (ignored by BPF/LPF/HPF)
+    // Q      = Q per band (ignored by the shelves)
+    // count  = number of bands
+    // fs     = sampling rate in Hz
+    static void calcCoeffsBands(float* coeffs, const int* types, const float* fc, const float* gainDb,
+                                const float* Q, int count, float fs);
+    
 };
 
 #endif /* defined(__filters__) */
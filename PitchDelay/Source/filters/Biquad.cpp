@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    Biquad.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "Biquad.h"
+#include "../filterCalc/FilterCalc.h"
+
+Biquad::Biquad()
+    : sample_rate(44100.0),
+      b0(1.0), b1(0.0), b2(0.0), a1(0.0), a2(0.0),
+      x1(0.0), x2(0.0), y1(0.0), y2(0.0)
+{
+}
+
+void Biquad::setCoefficients(const float* coeffs, bool clearState)
+{
+    setCoefficients(coeffs[0], coeffs[1], coeffs[2], coeffs[3], coeffs[4], clearState);
+}
+
+void Biquad::setCoefficients(double new_b0, double new_b1, double new_b2, double new_a1, double new_a2, bool clearState)
+{
+    b0 = new_b0;
+    b1 = new_b1;
+    b2 = new_b2;
+    a1 = new_a1;
+    a2 = new_a2;
+    
+    if (clearState) {
+        clear();
+    }
+}
+
+void Biquad::setHighPass(float fc, float Q)
+{
+    float coeffs[5];
+    FilterCalc::calcCoeffsHPF(coeffs, fc, Q, sample_rate);
+    setCoefficients(coeffs);
+}
+
+void Biquad::setLowPass(float fc, float Q)
+{
+    float coeffs[5];
+    FilterCalc::calcCoeffsLPF(coeffs, fc, Q, sample_rate);
+    setCoefficients(coeffs);
+}
+
+void Biquad::clear()
+{
+    x1 = x2 = y1 = y2 = 0.0;
+}
@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    Biquad.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Two-pole, two-zero filter used in the feedback path.
+//
+// Unlike stk::BiQuad, this keeps no static registries: there is no global
+// sample rate, no alert list and no shared error stream. Each filter owns its
+// sample rate and its coefficients, so constructing and destroying filters on
+// different threads at the same time is safe and costs the same no matter how
+// many other instances exist.
+
+class Biquad
+{
+public:
+    Biquad();
+
+    // The sample rate is only used by the design helpers below; setting it
+    // does not touch the current coefficients.
+    void setSampleRate(double sampleRate) { sample_rate = sampleRate; }
+    double getSampleRate() const { return sample_rate; }
+
+    // coeffs = [b0, b1, b2, a1, a2], the layout FilterCalc writes.
+    void setCoefficients(const float* coeffs, bool clearState = false);
+    void setCoefficients(double b0, double b1, double b2, double a1, double a2, bool clearState = false);
+
+    // Designs the filter from FilterCalc at this filter's own sample rate.
+    void setHighPass(float fc, float Q);
+    void setLowPass(float fc, float Q);
+
+    // Clears the filter history, keeping the coefficients.
+    void clear();
+
+    inline float tick(float input);
+
+private:
+    double sample_rate;
+
+    double b0, b1, b2, a1, a2;
+    double x1, x2, y1, y2;
+};
+
+inline float Biquad::tick(float input)
+{
+    double out = b0 * input + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+    x2 = x1;
+    x1 = input;
+    y2 = y1;
+    y1 = out;
+    return (float) out;
+}
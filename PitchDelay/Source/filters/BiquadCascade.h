@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    BiquadCascade.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Up to `max_bands` biquads in series, run in a single pass per sample.
+//
+// Coefficients are stored band-major in flat arrays rather than as separate
+// Biquad objects, so one tick walks contiguous memory. Bands whose
+// coefficients are an identity (a flat EQ band) are dropped when the
+// coefficients are loaded, so a flat EQ costs nothing per sample.
+// Each band is transposed direct form II with double state.
+
+template <int max_bands>
+class BiquadCascade
+{
+public:
+    BiquadCascade(): num_active(0)
+    {
+        clear();
+    }
+    
+    // coeffs = [b0, b1, b2, a1, a2] per band, as FilterCalc::calcCoeffsBands
+    // writes them. State is kept for bands that stay at the same index.
+    void setCoefficients(const float* coeffs, int numBands)
+    {
+        int active = 0;
+        for (int band = 0; band < numBands && band < max_bands; ++band) {
+            const float* c = coeffs + 5 * band;
+            if (c[0] == 1 && c[1] == c[3] && c[2] == c[4]) {
+                continue; // numerator == denominator: unity gain
+            }
+            if (band_index[active] != band) {
+                s1[active] = s2[active] = 0.0;
+            }
+            band_index[active] = band;
+            b0[active] = c[0];
+            b1[active] = c[1];
+            b2[active] = c[2];
+            a1[active] = c[3];
+            a2[active] = c[4];
+            active++;
+        }
+        for (int i = active; i < max_bands; ++i) {
+            band_index[i] = -1;
+        }
+        num_active = active;
+    }
+    
+    void clear()
+    {
+        for (int i = 0; i < max_bands; ++i) {
+            s1[i] = s2[i] = 0.0;
+            band_index[i] = -1;
+        }
+    }
+    
+    bool isFlat() const { return num_active == 0; }
+    
+    inline float tick(float input)
+    {
+        double x = input;
+        for (int i = 0; i < num_active; ++i) {
+            double y = b0[i] * x + s1[i];
+            s1[i] = b1[i] * x - a1[i] * y + s2[i];
+            s2[i] = b2[i] * x - a2[i] * y;
+            x = y;
+        }
+        return (float) x;
+    }
+    
+    void process(float* samples, int numSamples)
+    {
+        for (int n = 0; n < numSamples; ++n) {
+            samples[n] = tick(samples[n]);
+        }
+    }
+    
+private:
+    int num_active;
+    int band_index[max_bands];
+    double b0[max_bands], b1[max_bands], b2[max_bands], a1[max_bands], a2[max_bands];
+    double s1[max_bands], s2[max_bands];
+};
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    DelayHistory.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "DelayHistory.h"
+
+DelayHistory::DelayHistory(): num_channels(0), num_samples(0)
+{
+    for (int i = 0; i < max_channels; ++i) {
+        channels[i] = nullptr;
+    }
+}
+
+DelayHistory::~DelayHistory()
+{
+    release();
+}
+
+bool DelayHistory::allocate(int numChannels, int numSamples)
+{
+    release();
+    if (numChannels <= 0 || numChannels > max_channels || numSamples <= 0) {
+        return false;
+    }
+    
+    // Pad every channel (plus the guard sample) out to a whole cache line.
+    const size_t floats_per_line = HistoryPool::alignment / sizeof(float);
+    const size_t stride = ((size_t) numSamples + 1 + floats_per_line - 1) / floats_per_line * floats_per_line;
+    
+    block = HistoryPool::getInstance().acquire(stride * numChannels * sizeof(float));
+    if (block.data == nullptr) {
+        return false;
+    }
+    
+    float* data = static_cast<float*>(block.data);
+    for (int i = 0; i < numChannels; ++i) {
+        channels[i] = data + stride * i;
+    }
+    num_channels = numChannels;
+    num_samples = numSamples;
+    return true;
+}
+
+void DelayHistory::release()
+{
+    HistoryPool::getInstance().release(block);
+    for (int i = 0; i < max_channels; ++i) {
+        channels[i] = nullptr;
+    }
+    num_channels = 0;
+    num_samples = 0;
+}
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    DelayHistory.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "HistoryPool.h"
+
+// Multichannel delay line storage backed by a HistoryPool block.
+//
+// Channels are laid out back to back, each starting on a cache line, with
+// one spare sample past the end so the interpolation in getInBetween can
+// read index + 1 at the last position without leaving the channel.
+class DelayHistory
+{
+public:
+    static const int max_channels = 8;
+    
+    DelayHistory();
+    ~DelayHistory();
+    
+    // Hands back the current block (if any) and takes a zeroed one big enough
+    // for `numChannels` x `numSamples`. Returns false if that failed, in which
+    // case the history is left empty.
+    bool allocate(int numChannels, int numSamples);
+    
+    // Returns the block to the pool.
+    void release();
+    
+    bool isAllocated() const { return block.data != nullptr; }
+    int getNumChannels() const { return num_channels; }
+    int getNumSamples() const { return num_samples; }
+    
+    float* getWritePointer(int channel) { return channels[channel]; }
+    const float* getReadPointer(int channel) const { return channels[channel]; }
+    
+private:
+    HistoryBlock block;
+    float* channels[max_channels];
+    int num_channels;
+    int num_samples;
+    
+    DelayHistory(const DelayHistory&) = delete;
+    DelayHistory& operator=(const DelayHistory&) = delete;
+};
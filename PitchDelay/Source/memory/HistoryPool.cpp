@@ -0,0 +1,237 @@
+/*
+  ==============================================================================
+
+    HistoryPool.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "HistoryPool.h"
+#include <cstring>
+#include <new>
+
+#if SPLUTTER_MMAP_HISTORY
+ #include <sys/mman.h>
+#endif
+
+HistoryPool& HistoryPool::getInstance()
+{
+    // Constructed on first use; C++11 makes this initialisation thread safe.
+    static HistoryPool pool;
+    return pool;
+}
+
+HistoryPool::HistoryPool()
+{
+    std::memset(&stats, 0, sizeof(stats));
+    stats.cap_bytes = default_cap_bytes;
+}
+
+HistoryPool::~HistoryPool()
+{
+    trim();
+}
+
+int HistoryPool::sizeClassForBytes(size_t bytes)
+{
+    // Classes go 1, 1.25, 1.5, 1.75, 2, 2.5, ... times a power of two,
+    // starting at one page.
+    for (int size_class = 0; size_class < num_size_classes; ++size_class) {
+        if (bytesForSizeClass(size_class) >= bytes) {
+            return size_class;
+        }
+    }
+    return -1;
+}
+
+size_t HistoryPool::bytesForSizeClass(int size_class)
+{
+    const size_t base = (size_t) 4096 << (size_class / 4);
+    return base + (base / 4) * (size_class % 4);
+}
+
+#if SPLUTTER_MMAP_HISTORY
+
+static size_t roundUpToHugePage(size_t bytes)
+{
+    return (bytes + HistoryPool::huge_page_bytes - 1) / HistoryPool::huge_page_bytes * HistoryPool::huge_page_bytes;
+}
+
+void* HistoryPool::allocateBlock(size_t bytes)
+{
+    // Over-map by one huge page so the block can start on a 2 MB boundary,
+    // which lets the kernel back it with huge pages from the first fault.
+    const size_t mapped = roundUpToHugePage(bytes);
+    const size_t reserve = mapped + huge_page_bytes;
+    void* raw = mmap(nullptr, reserve, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (raw == MAP_FAILED) {
+        return nullptr;
+    }
+    
+    char* start = static_cast<char*>(raw);
+    char* aligned = reinterpret_cast<char*>(((size_t) start + huge_page_bytes - 1) / huge_page_bytes * huge_page_bytes);
+    if (aligned > start) {
+        munmap(start, aligned - start);
+    }
+    char* end = aligned + mapped;
+    if (start + reserve > end) {
+        munmap(end, start + reserve - end);
+    }
+    
+   #ifdef MADV_HUGEPAGE
+    madvise(aligned, mapped, MADV_HUGEPAGE);
+   #endif
+    return aligned;
+}
+
+void HistoryPool::freeBlock(void* data, size_t bytes)
+{
+    munmap(data, roundUpToHugePage(bytes));
+}
+
+void HistoryPool::zeroBlock(void* data, size_t bytes)
+{
+    // Dropping the pages is enough: the next read of an anonymous private
+    // mapping sees the kernel's zero page, and the next write commits a fresh
+    // zeroed page. Only fresh mappings skip this entirely.
+    madvise(data, roundUpToHugePage(bytes), MADV_DONTNEED);
+}
+
+#else
+
+void* HistoryPool::allocateBlock(size_t bytes)
+{
+    void* data = ::operator new(bytes, std::align_val_t(alignment), std::nothrow);
+    if (data != nullptr) {
+        zeroBlock(data, bytes);
+    }
+    return data;
+}
+
+void HistoryPool::freeBlock(void* data, size_t bytes)
+{
+    ::operator delete(data, std::align_val_t(alignment));
+}
+
+void HistoryPool::zeroBlock(void* data, size_t bytes)
+{
+    std::memset(data, 0, bytes);
+}
+
+#endif
+
+HistoryBlock HistoryPool::acquire(size_t bytes)
+{
+    HistoryBlock block;
+    const int size_class = sizeClassForBytes(bytes);
+    if (size_class < 0) {
+        return block;
+    }
+    block.size_class = size_class;
+    block.bytes = bytesForSizeClass(size_class);
+    
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        std::vector<void*>& list = free_blocks[size_class];
+        if (! list.empty()) {
+            block.data = list.back();
+            list.pop_back();
+            stats.pooled_bytes -= block.bytes;
+            stats.pooled_blocks--;
+            stats.in_use_bytes += block.bytes;
+            stats.in_use_blocks++;
+            stats.hits++;
+            return block;
+        }
+        stats.misses++;
+    }
+    
+    // Allocate outside the lock so other instances aren't held up. New blocks
+    // come back already zeroed.
+    block.data = allocateBlock(block.bytes);
+    if (block.data == nullptr) {
+        return HistoryBlock();
+    }
+    
+    std::lock_guard<std::mutex> guard(lock);
+    stats.in_use_bytes += block.bytes;
+    stats.in_use_blocks++;
+    return block;
+}
+
+void HistoryPool::release(HistoryBlock& block)
+{
+    if (block.data == nullptr) {
+        return;
+    }
+    
+    bool keep;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stats.in_use_bytes -= block.bytes;
+        stats.in_use_blocks--;
+        keep = stats.pooled_bytes + block.bytes <= stats.cap_bytes;
+        if (! keep) {
+            stats.evictions++;
+        }
+    }
+    
+    if (keep) {
+        zeroBlock(block.data, block.bytes);
+        
+        std::lock_guard<std::mutex> guard(lock);
+        // The cap may have been lowered while we were clearing.
+        if (stats.pooled_bytes + block.bytes <= stats.cap_bytes) {
+            free_blocks[block.size_class].push_back(block.data);
+            stats.pooled_bytes += block.bytes;
+            stats.pooled_blocks++;
+            block = HistoryBlock();
+            return;
+        }
+        stats.evictions++;
+    }
+    
+    freeBlock(block.data, block.bytes);
+    block = HistoryBlock();
+}
+
+void HistoryPool::setCapBytes(size_t cap)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    stats.cap_bytes = cap;
+    evictToCap();
+}
+
+void HistoryPool::evictToCap()
+{
+    for (int size_class = num_size_classes - 1; size_class >= 0; --size_class) {
+        std::vector<void*>& list = free_blocks[size_class];
+        while (stats.pooled_bytes > stats.cap_bytes && ! list.empty()) {
+            freeBlock(list.back(), bytesForSizeClass(size_class));
+            list.pop_back();
+            stats.pooled_bytes -= bytesForSizeClass(size_class);
+            stats.pooled_blocks--;
+            stats.evictions++;
+        }
+    }
+}
+
+void HistoryPool::trim()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    for (int size_class = 0; size_class < num_size_classes; ++size_class) {
+        for (void* data : free_blocks[size_class]) {
+            freeBlock(data, bytesForSizeClass(size_class));
+        }
+        free_blocks[size_class].clear();
+    }
+    stats.pooled_bytes = 0;
+    stats.pooled_blocks = 0;
+}
+
+HistoryPoolStats HistoryPool::getStats() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return stats;
+}
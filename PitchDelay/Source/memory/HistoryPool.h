@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    HistoryPool.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// On Linux, history blocks are backed by anonymous mmap with transparent huge
+// pages. Fresh mappings read as zero, so nothing is cleared up front and pages
+// are only committed once the write pointer reaches them. Define this to 0 to
+// use the aligned heap allocator everywhere.
+#ifndef SPLUTTER_MMAP_HISTORY
+ #if defined(__linux__)
+  #define SPLUTTER_MMAP_HISTORY 1
+ #else
+  #define SPLUTTER_MMAP_HISTORY 0
+ #endif
+#endif
+
+// A large, cache-line aligned block of delay history. `bytes` is the usable
+// capacity, which is the requested size rounded up to the block's size class.
+struct HistoryBlock {
+    void* data;
+    size_t bytes;
+    int size_class;
+    
+    HistoryBlock(): data(nullptr), bytes(0), size_class(-1) {}
+};
+
+// With SPLUTTER_MMAP_HISTORY the byte counts are address space reserved, not
+// memory committed.
+struct HistoryPoolStats {
+    size_t cap_bytes;
+    size_t pooled_bytes;     // zeroed blocks waiting to be reused
+    size_t in_use_bytes;     // blocks currently held by instances
+    int pooled_blocks;
+    int in_use_blocks;
+    long hits;               // acquires served from the pool
+    long misses;             // acquires that had to allocate
+    long evictions;          // released blocks freed because of the cap
+};
+
+// Process-wide pool of delay history blocks, shared by every plugin instance.
+//
+// Instances take a zeroed block in prepareToPlay and hand it back in
+// releaseResources, so dormant instances don't pin their worst-case history.
+// Blocks are kept in quarter-octave size classes: asking for N bytes returns
+// the smallest class that fits, wasting at most ~19%. Returned blocks are
+// zeroed before they go back on the free list, so acquire never has to clear.
+// With SPLUTTER_MMAP_HISTORY, "zeroing" is a madvise that drops the pages, so
+// a pooled block costs no resident memory until it is written again.
+//
+// acquire and release lock a mutex and may allocate, so only call them from
+// prepareToPlay / releaseResources, never from the audio callback.
+class HistoryPool
+{
+public:
+    static HistoryPool& getInstance();
+    
+    ~HistoryPool();
+    
+    static const size_t alignment = 64;
+    static const size_t huge_page_bytes = (size_t) 2 * 1024 * 1024;
+    static const size_t default_cap_bytes = (size_t) 256 * 1024 * 1024;
+    
+    // Returns a zeroed block of at least `bytes` bytes, or an empty block if
+    // the allocation failed.
+    HistoryBlock acquire(size_t bytes);
+    
+    // Hands a block back to the pool and empties `block`. If keeping it would
+    // push the pool over its cap, the block is freed instead.
+    void release(HistoryBlock& block);
+    
+    // Maximum number of bytes kept on the free lists. Lowering the cap frees
+    // pooled blocks straight away, largest first.
+    void setCapBytes(size_t cap);
+    
+    // Frees every pooled block. Blocks in use are not affected.
+    void trim();
+    
+    HistoryPoolStats getStats() const;
+    
+    static int sizeClassForBytes(size_t bytes);
+    static size_t bytesForSizeClass(int size_class);
+    
+private:
+    HistoryPool();
+    
+    static const int num_size_classes = 4 * 48;
+    
+    void evictToCap();
+    static void* allocateBlock(size_t bytes);
+    static void freeBlock(void* data, size_t bytes);
+    static void zeroBlock(void* data, size_t bytes);
+    
+    mutable std::mutex lock;
+    std::vector<void*> free_blocks[num_size_classes];
+    HistoryPoolStats stats;
+};
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    ZoneProfiler.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ZoneProfiler.h"
+
+#if SPLUTTER_PROFILE
+
+#include <algorithm> // min
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+
+// Static, so a thread's first zone claims a buffer without allocating.
+static zone_profiler::ZoneBuffer thread_buffers[zone_profiler::max_threads];
+static std::atomic<int> num_thread_buffers (0);
+
+int64_t zone_profiler::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+zone_profiler::ZoneBuffer* zone_profiler::getThreadBuffer()
+{
+    thread_local bool claimed = false;
+    thread_local ZoneBuffer* buffer = nullptr;
+    if (! claimed) {
+        claimed = true;
+        const int index = num_thread_buffers.fetch_add(1);
+        if (index < max_threads) {
+            buffer = &thread_buffers[index];
+        }
+    }
+    return buffer;
+}
+
+void zone_profiler::record(const ZoneEvent& event)
+{
+    ZoneBuffer* buffer = getThreadBuffer();
+    if (buffer == nullptr) {
+        return;
+    }
+    const uint32_t head = buffer->head.load(std::memory_order_relaxed);
+    if (head - buffer->tail.load(std::memory_order_acquire) == (uint32_t) buffer_capacity) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->events[head % buffer_capacity] = event;
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+static void writeEvent(std::ostream& out, const zone_profiler::ZoneEvent& event, int process, int thread)
+{
+    // Chrome traces count in microseconds.
+    out << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":" << process << ",\"tid\":" << thread
+        << ",\"ts\":" << event.begin / 1000.0 << ",\"dur\":" << (event.end - event.begin) / 1000.0;
+    if (event.details[0] != nullptr) {
+        out << ",\"args\":{\"detail\":\"";
+        for (int i = 0; i < zone_profiler::max_details && event.details[i] != nullptr; ++i) {
+            out << (i > 0 ? " " : "") << event.details[i];
+        }
+        out << "\"}";
+    }
+    out << "}";
+}
+
+int zone_profiler::writeChromeTrace(std::ostream& out)
+{
+    // Instances keep their numbers from one export to the next.
+    static std::mutex export_lock;
+    static std::vector<const void*> instances;
+    std::lock_guard<std::mutex> lock (export_lock);
+    
+    // Nanosecond timestamps, in microseconds with all their digits.
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+    
+    int written = 0;
+    bool first = true;
+    out << "{\"traceEvents\":[";
+    const int threads = std::min(num_thread_buffers.load(), max_threads);
+    for (int thread = 0; thread < threads; ++thread) {
+        ZoneBuffer& buffer = thread_buffers[thread];
+        const uint32_t head = buffer.head.load(std::memory_order_acquire);
+        uint32_t tail = buffer.tail.load(std::memory_order_relaxed);
+        for (; tail != head; ++tail) {
+            const ZoneEvent& event = buffer.events[tail % buffer_capacity];
+            int process = 0;
+            while (process < (int) instances.size() && instances[process] != event.instance) {
+                ++process;
+            }
+            if (process == (int) instances.size()) {
+                instances.push_back(event.instance);
+                out << (first ? "" : ",") << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << process
+                    << ",\"args\":{\"name\":\"instance " << process << "\"}}";
+                first = false;
+            }
+            out << (first ? "" : ",");
+            writeEvent(out, event, process, thread);
+            first = false;
+            ++written;
+        }
+        buffer.tail.store(tail, std::memory_order_release);
+        const uint32_t dropped = buffer.dropped.exchange(0);
+        if (dropped > 0) {
+            out << (first ? "" : ",") << "{\"name\":\"dropped zones\",\"ph\":\"C\",\"pid\":0,\"tid\":" << thread
+                << ",\"ts\":" << now() / 1000.0 << ",\"args\":{\"zones\":" << dropped << "}}";
+            first = false;
+        }
+    }
+    out << "]}\n";
+    out.flags(flags);
+    out.precision(precision);
+    return written;
+}
+
+#endif
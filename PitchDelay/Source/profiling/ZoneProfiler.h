@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    ZoneProfiler.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <ostream>
+
+// Scoped timing zones for the engine, written out as a Chrome trace
+// (chrome://tracing, or ui.perfetto.dev).
+//
+// Build with SPLUTTER_PROFILE=1 to turn them on. Otherwise the zone macros
+// expand to nothing, and none of this is compiled in.
+//
+//     SPLUTTER_ZONE("parameters");
+//     SPLUTTER_ZONE_DETAIL("kernel", pitch_name, feedback_name, 0, 0);
+//
+// A zone runs from the macro to the end of the enclosing scope, and zones
+// inside it nest under it in the trace. Each thread records into its own
+// buffer without locking, so the audio thread never waits for the exporter;
+// if a buffer fills up before it is exported, new zones are dropped and
+// counted. Every plugin instance is its own process in the trace.
+#ifndef SPLUTTER_PROFILE
+ #define SPLUTTER_PROFILE 0
+#endif
+
+#if SPLUTTER_PROFILE
+
+namespace zone_profiler {
+    // Details are up to four static strings, such as regime names, shown
+    // with the zone. Unused ones are null.
+    const int max_details = 4;
+    const int buffer_capacity = 1 << 15; // zones per thread between exports
+    const int max_threads = 8;
+
+    struct ZoneEvent {
+        const char* name;
+        const void* instance;
+        int64_t begin, end; // ns
+        const char* details[max_details];
+    };
+
+    // One recording thread's zones, handed to the exporter through a ring.
+    struct ZoneBuffer {
+        std::atomic<uint32_t> head;    // written by the recording thread
+        std::atomic<uint32_t> tail;    // written by the exporter
+        std::atomic<uint32_t> dropped;
+        ZoneEvent events[buffer_capacity];
+    };
+
+    int64_t now();
+    // Null once max_threads threads have recorded; their zones are lost.
+    ZoneBuffer* getThreadBuffer();
+    void record(const ZoneEvent& event);
+
+    // Takes every zone recorded so far, from every thread, and writes them
+    // as a Chrome trace. Returns the number of zones written. Call from one
+    // thread at a time, never the audio thread.
+    int writeChromeTrace(std::ostream& out);
+
+    class Zone
+    {
+    public:
+        Zone(const char* name, const void* instance,
+             const char* d0 = nullptr, const char* d1 = nullptr, const char* d2 = nullptr, const char* d3 = nullptr) {
+            event.name = name;
+            event.instance = instance;
+            event.details[0] = d0;
+            event.details[1] = d1;
+            event.details[2] = d2;
+            event.details[3] = d3;
+            event.begin = now();
+        }
+        ~Zone() {
+            event.end = now();
+            record(event);
+        }
+
+    private:
+        ZoneEvent event;
+    };
+}
+
+ #define SPLUTTER_ZONE_JOIN2(a, b) a##b
+ #define SPLUTTER_ZONE_JOIN(a, b) SPLUTTER_ZONE_JOIN2(a, b)
+ #define SPLUTTER_ZONE(name) \
+    zone_profiler::Zone SPLUTTER_ZONE_JOIN(splutter_zone_, __LINE__) (name, this)
+ #define SPLUTTER_ZONE_DETAIL(name, d0, d1, d2, d3) \
+    zone_profiler::Zone SPLUTTER_ZONE_JOIN(splutter_zone_, __LINE__) (name, this, d0, d1, d2, d3)
+
+#else
+
+ #define SPLUTTER_ZONE(name)
+ #define SPLUTTER_ZONE_DETAIL(name, d0, d1, d2, d3)
+
+#endif
@@ -0,0 +1,633 @@
+/*
+  ==============================================================================
+
+    splutter_python.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+// The splutter Python module, over the C interface (core/splutter.h).
+//
+//     import numpy as np, splutter
+//     engine = splutter.Engine(48000)
+//     engine.set_param("pitch_shift", 7)
+//     audio = np.zeros((2, 48000), dtype=np.float32)   # channels, frames
+//     engine.process(audio, automation={"dry_wet": np.linspace(0, 1, 48000, dtype=np.float32)})
+//
+// Audio is anything with the buffer protocol holding float32 (or float64),
+// C contiguous and writable: a 2-D (channels, frames) array, a 1-D array for
+// mono, or a list of 1-D arrays, one per channel. It is processed in place,
+// without a copy, and without the GIL, so engines in different threads run
+// at the same time. Nothing here needs NumPy to build or to run.
+//
+// Automation maps parameter names to a value or an array with one value per
+// frame. The audio is processed in blocks of block_size frames, like a host
+// would, and each block takes the value at its last frame, which the engine
+// ramps to across the block, as it does with host automation.
+//
+// Keys are (frame, note, down) tuples in frame order, for playing the pitch
+// with key_mode on. Each lands on its own frame, whatever the block size.
+//
+// Like splutterd's main, it is only compiled with SPLUTTER_PYTHON=1, so that
+// builds taking in every source file don't need the Python headers.
+
+#if SPLUTTER_PYTHON
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include "../core/splutter.h"
+#include <string.h>
+#include <vector>
+
+struct ParameterName {
+    const char* name;
+    splutter_param param;
+};
+static const ParameterName parameter_names[SPLUTTER_NUM_PARAMS] = {
+    { "feedback", SPLUTTER_PARAM_FEEDBACK },
+    { "dry_wet", SPLUTTER_PARAM_DRY_WET },
+    { "pitch_shift", SPLUTTER_PARAM_PITCH_SHIFT },
+    { "rate", SPLUTTER_PARAM_RATE },
+    { "min_delay", SPLUTTER_PARAM_MIN_DELAY },
+    { "lo_cut", SPLUTTER_PARAM_LO_CUT },
+    { "hi_cut", SPLUTTER_PARAM_HI_CUT },
+    { "eq_placement", SPLUTTER_PARAM_EQ_PLACEMENT },
+    { "rate_sync", SPLUTTER_PARAM_RATE_SYNC },
+    { "delay_sync", SPLUTTER_PARAM_DELAY_SYNC },
+    { "engine", SPLUTTER_PARAM_ENGINE },
+    { "overlap", SPLUTTER_PARAM_OVERLAP },
+    { "shape", SPLUTTER_PARAM_SHAPE },
+    { "stereo_feedback", SPLUTTER_PARAM_STEREO_FEEDBACK },
+    { "feedback_width", SPLUTTER_PARAM_FEEDBACK_WIDTH },
+    { "saturation", SPLUTTER_PARAM_SATURATION },
+    { "drive", SPLUTTER_PARAM_DRIVE },
+    { "delay_change", SPLUTTER_PARAM_DELAY_CHANGE },
+    { "glide_time", SPLUTTER_PARAM_GLIDE_TIME },
+    { "glide_curve", SPLUTTER_PARAM_GLIDE_CURVE },
+    { "key_mode", SPLUTTER_PARAM_KEY_MODE },
+    { "root_note", SPLUTTER_PARAM_ROOT_NOTE },
+};
+
+// A parameter is a name from parameter_names or its index. Returns -1 with
+// an exception set if it is neither.
+static int getParam(PyObject* key)
+{
+    if (PyLong_Check(key)) {
+        long index = PyLong_AsLong(key);
+        if (index >= 0 && index < SPLUTTER_NUM_PARAMS) {
+            return (int) index;
+        }
+    } else if (PyUnicode_Check(key)) {
+        const char* name = PyUnicode_AsUTF8(key);
+        if (name == nullptr) {
+            return -1;
+        }
+        for (const ParameterName& entry : parameter_names) {
+            if (strcmp(entry.name, name) == 0) {
+                return entry.param;
+            }
+        }
+    }
+    PyErr_Format(PyExc_KeyError, "unknown parameter %R", key);
+    return -1;
+}
+
+// 'f' for float32, 'd' for float64, or 0. Native and little-endian formats
+// are both fine on the machines this runs on.
+static char getSampleType(const Py_buffer& view)
+{
+    const char* format = view.format != nullptr ? view.format : "B";
+    if (*format == '@' || *format == '=' || *format == '<') {
+        ++format;
+    }
+    if (strcmp(format, "f") == 0 && view.itemsize == 4) {
+        return 'f';
+    }
+    if (strcmp(format, "d") == 0 && view.itemsize == 8) {
+        return 'd';
+    }
+    return 0;
+}
+
+//==============================================================================
+// The buffers a process call holds on to while the GIL is released.
+struct AudioViews {
+    Py_buffer views[SPLUTTER_MAX_CHANNELS];
+    int num_views;
+    char* channels[SPLUTTER_MAX_CHANNELS];
+    int num_channels;
+    Py_ssize_t num_frames;
+    char sample_type;
+
+    AudioViews(): num_views(0), num_channels(0), num_frames(0), sample_type(0) {}
+    ~AudioViews() {
+        for (int i = 0; i < num_views; ++i) {
+            PyBuffer_Release(&views[i]);
+        }
+    }
+};
+
+static bool addAudioView(AudioViews& audio, PyObject* object, bool wholeBuffer)
+{
+    Py_buffer& view = audio.views[audio.num_views];
+    if (PyObject_GetBuffer(object, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | PyBUF_WRITABLE) != 0) {
+        return false;
+    }
+    ++audio.num_views;
+
+    const char sample_type = getSampleType(view);
+    if (sample_type == 0 || (audio.sample_type != 0 && sample_type != audio.sample_type)) {
+        PyErr_SetString(PyExc_TypeError, "audio must be float32 or float64, the same for every channel");
+        return false;
+    }
+    audio.sample_type = sample_type;
+
+    const bool is_2d = wholeBuffer && view.ndim == 2;
+    if (! is_2d && view.ndim != 1) {
+        PyErr_SetString(PyExc_ValueError, "audio must be (channels, frames), (frames,) or a list of (frames,)");
+        return false;
+    }
+    const Py_ssize_t num_channels = is_2d ? view.shape[0] : 1;
+    const Py_ssize_t num_frames = is_2d ? view.shape[1] : view.shape[0];
+    if (audio.num_channels + num_channels > SPLUTTER_MAX_CHANNELS) {
+        PyErr_Format(PyExc_ValueError, "at most %d channels", SPLUTTER_MAX_CHANNELS);
+        return false;
+    }
+    if (audio.num_channels > 0 && num_frames != audio.num_frames) {
+        PyErr_SetString(PyExc_ValueError, "every channel must have the same number of frames");
+        return false;
+    }
+    if (num_frames > INT_MAX) {
+        PyErr_SetString(PyExc_ValueError, "too many frames");
+        return false;
+    }
+    audio.num_frames = num_frames;
+    for (Py_ssize_t channel = 0; channel < num_channels; ++channel) {
+        audio.channels[audio.num_channels++] = static_cast<char*>(view.buf) + channel * num_frames * view.itemsize;
+    }
+    return true;
+}
+
+static bool getAudioViews(AudioViews& audio, PyObject* object)
+{
+    if (PyObject_CheckBuffer(object)) {
+        return addAudioView(audio, object, true);
+    }
+    if (PyList_Check(object) || PyTuple_Check(object)) {
+        const Py_ssize_t count = PySequence_Fast_GET_SIZE(object);
+        if (count == 0 || count > SPLUTTER_MAX_CHANNELS) {
+            PyErr_Format(PyExc_ValueError, "between 1 and %d channels", SPLUTTER_MAX_CHANNELS);
+            return false;
+        }
+        for (Py_ssize_t i = 0; i < count; ++i) {
+            if (! addAudioView(audio, PySequence_Fast_GET_ITEM(object, i), false)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    PyErr_SetString(PyExc_TypeError, "audio must support the buffer protocol, or be a list of channels that do");
+    return false;
+}
+
+// One automated parameter: a value per frame, or one value throughout.
+struct AutomationLane {
+    splutter_param param;
+    Py_buffer view;
+    bool has_view;
+    char sample_type;
+    float value;
+
+    float getValue(Py_ssize_t frame) const {
+        if (! has_view) {
+            return value;
+        }
+        return sample_type == 'f' ? static_cast<const float*>(view.buf)[frame]
+                                  : (float) static_cast<const double*>(view.buf)[frame];
+    }
+};
+
+struct Automation {
+    AutomationLane lanes[SPLUTTER_NUM_PARAMS];
+    int num_lanes;
+
+    Automation(): num_lanes(0) {}
+    ~Automation() {
+        for (int i = 0; i < num_lanes; ++i) {
+            if (lanes[i].has_view) {
+                PyBuffer_Release(&lanes[i].view);
+            }
+        }
+    }
+};
+
+static bool getAutomation(Automation& automation, PyObject* mapping, Py_ssize_t numFrames)
+{
+    if (mapping == nullptr || mapping == Py_None) {
+        return true;
+    }
+    if (! PyDict_Check(mapping)) {
+        PyErr_SetString(PyExc_TypeError, "automation must be a dict of parameter names to values or arrays");
+        return false;
+    }
+    PyObject* key;
+    PyObject* values;
+    Py_ssize_t position = 0;
+    while (PyDict_Next(mapping, &position, &key, &values)) {
+        const int param = getParam(key);
+        if (param < 0) {
+            return false;
+        }
+        // A name and an index can both reach the same parameter.
+        for (int i = 0; i < automation.num_lanes; ++i) {
+            if (automation.lanes[i].param == param) {
+                PyErr_SetString(PyExc_ValueError, "a parameter is automated twice");
+                return false;
+            }
+        }
+        AutomationLane& lane = automation.lanes[automation.num_lanes];
+        lane.param = (splutter_param) param;
+        lane.has_view = false;
+        if (PyFloat_Check(values) || PyLong_Check(values)) {
+            lane.value = (float) PyFloat_AsDouble(values);
+            ++automation.num_lanes;
+            continue;
+        }
+        if (PyObject_GetBuffer(values, &lane.view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+            return false;
+        }
+        lane.has_view = true;
+        ++automation.num_lanes;
+        lane.sample_type = getSampleType(lane.view);
+        if (lane.sample_type == 0 || lane.view.ndim != 1 || lane.view.shape[0] != numFrames) {
+            PyErr_Format(PyExc_ValueError, "automation for %R must be float32 or float64 with one value per frame", key);
+            return false;
+        }
+    }
+    return true;
+}
+
+struct Key {
+    Py_ssize_t frame;
+    int note;
+    bool down;
+};
+
+static bool getKeys(std::vector<Key>& keys, PyObject* sequence, Py_ssize_t numFrames)
+{
+    if (sequence == nullptr || sequence == Py_None) {
+        return true;
+    }
+    PyObject* items = PySequence_Fast(sequence, "keys must be a sequence of (frame, note, down) tuples");
+    if (items == nullptr) {
+        return false;
+    }
+    const Py_ssize_t count = PySequence_Fast_GET_SIZE(items);
+    keys.reserve(count);
+    for (Py_ssize_t i = 0; i < count; ++i) {
+        Key key;
+        int down;
+        if (! PyArg_ParseTuple(PySequence_Fast_GET_ITEM(items, i), "nip;keys must be (frame, note, down) tuples",
+                               &key.frame, &key.note, &down)) {
+            Py_DECREF(items);
+            return false;
+        }
+        key.down = down != 0;
+        if (key.frame < 0 || key.frame >= numFrames || (! keys.empty() && key.frame < keys.back().frame)) {
+            Py_DECREF(items);
+            PyErr_SetString(PyExc_ValueError, "key frames must be in order and within the audio");
+            return false;
+        }
+        keys.push_back(key);
+    }
+    Py_DECREF(items);
+    return true;
+}
+
+//==============================================================================
+struct EngineObject {
+    PyObject_HEAD
+    splutter* engine;
+    double sample_rate;
+    // Set while a process call runs without the GIL, so a second thread
+    // gets an error instead of racing the first on the same engine.
+    bool busy;
+};
+
+static bool checkIdle(EngineObject* self)
+{
+    if (self->busy) {
+        PyErr_SetString(PyExc_RuntimeError, "the engine is processing in another thread");
+        return false;
+    }
+    return true;
+}
+
+static PyObject* Engine_new(PyTypeObject* type, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = { "sample_rate", nullptr };
+    double sample_rate;
+    if (! PyArg_ParseTupleAndKeywords(args, kwargs, "d", const_cast<char**>(keywords), &sample_rate)) {
+        return nullptr;
+    }
+    if (! (sample_rate > 0)) {
+        PyErr_SetString(PyExc_ValueError, "sample_rate must be positive");
+        return nullptr;
+    }
+    EngineObject* self = reinterpret_cast<EngineObject*>(type->tp_alloc(type, 0));
+    if (self == nullptr) {
+        return nullptr;
+    }
+    self->sample_rate = sample_rate;
+    self->busy = false;
+    Py_BEGIN_ALLOW_THREADS
+    self->engine = splutter_create(sample_rate);
+    Py_END_ALLOW_THREADS
+    if (self->engine == nullptr) {
+        Py_DECREF(self);
+        return PyErr_NoMemory();
+    }
+    return reinterpret_cast<PyObject*>(self);
+}
+
+static void Engine_dealloc(EngineObject* self)
+{
+    // Engine is a heap type, so each instance holds a reference to it.
+    PyTypeObject* type = Py_TYPE(self);
+    splutter_destroy(self->engine);
+    type->tp_free(reinterpret_cast<PyObject*>(self));
+    Py_DECREF(type);
+}
+
+static PyObject* Engine_set_param(EngineObject* self, PyObject* args)
+{
+    PyObject* key;
+    float value;
+    if (! PyArg_ParseTuple(args, "Of", &key, &value) || ! checkIdle(self)) {
+        return nullptr;
+    }
+    const int param = getParam(key);
+    if (param < 0) {
+        return nullptr;
+    }
+    splutter_set_param(self->engine, (splutter_param) param, value);
+    Py_RETURN_NONE;
+}
+
+static PyObject* Engine_get_param(EngineObject* self, PyObject* key)
+{
+    const int param = getParam(key);
+    if (param < 0) {
+        return nullptr;
+    }
+    return PyFloat_FromDouble(splutter_get_param(self->engine, (splutter_param) param));
+}
+
+static PyObject* Engine_set_eq_band(EngineObject* self, PyObject* args)
+{
+    int band;
+    float freq, gain, q;
+    if (! PyArg_ParseTuple(args, "ifff", &band, &freq, &gain, &q) || ! checkIdle(self)) {
+        return nullptr;
+    }
+    splutter_set_eq_band(self->engine, band, freq, gain, q);
+    Py_RETURN_NONE;
+}
+
+static PyObject* Engine_set_transport(EngineObject* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = { "bpm", "ppq", "playing", nullptr };
+    double bpm;
+    double ppq = 0;
+    int playing = 0;
+    if (! PyArg_ParseTupleAndKeywords(args, kwargs, "d|dp", const_cast<char**>(keywords), &bpm, &ppq, &playing)
+        || ! checkIdle(self)) {
+        return nullptr;
+    }
+    splutter_set_transport(self->engine, bpm, ppq, playing);
+    Py_RETURN_NONE;
+}
+
+static PyObject* Engine_switch_program(EngineObject* self, PyObject*)
+{
+    if (! checkIdle(self)) {
+        return nullptr;
+    }
+    splutter_switch_program(self->engine);
+    Py_RETURN_NONE;
+}
+
+static PyObject* Engine_set_drawn_trajectory(EngineObject* self, PyObject* points)
+{
+    if (! checkIdle(self)) {
+        return nullptr;
+    }
+    PyObject* sequence = PySequence_Fast(points, "points must be a sequence of numbers");
+    if (sequence == nullptr) {
+        return nullptr;
+    }
+    float values[64];
+    const Py_ssize_t count = PySequence_Fast_GET_SIZE(sequence);
+    if (count > 64) {
+        Py_DECREF(sequence);
+        PyErr_SetString(PyExc_ValueError, "at most 64 points");
+        return nullptr;
+    }
+    for (Py_ssize_t i = 0; i < count; ++i) {
+        values[i] = (float) PyFloat_AsDouble(PySequence_Fast_GET_ITEM(sequence, i));
+    }
+    Py_DECREF(sequence);
+    if (PyErr_Occurred()) {
+        return nullptr;
+    }
+    splutter_set_drawn_trajectory(self->engine, values, (int) count);
+    Py_RETURN_NONE;
+}
+
+static PyObject* Engine_reset(EngineObject* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = { "sample_rate", nullptr };
+    double sample_rate = self->sample_rate;
+    if (! PyArg_ParseTupleAndKeywords(args, kwargs, "|d", const_cast<char**>(keywords), &sample_rate)
+        || ! checkIdle(self)) {
+        return nullptr;
+    }
+    if (! (sample_rate > 0)) {
+        PyErr_SetString(PyExc_ValueError, "sample_rate must be positive");
+        return nullptr;
+    }
+    self->sample_rate = sample_rate;
+    self->busy = true;
+    int done;
+    Py_BEGIN_ALLOW_THREADS
+    done = splutter_reset(self->engine, sample_rate);
+    Py_END_ALLOW_THREADS
+    self->busy = false;
+    if (! done) {
+        return PyErr_NoMemory();
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* Engine_process(EngineObject* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = { "audio", "automation", "block_size", "keys", nullptr };
+    PyObject* audio_object;
+    PyObject* automation_object = nullptr;
+    int block_size = 512;
+    PyObject* keys_object = nullptr;
+    if (! PyArg_ParseTupleAndKeywords(args, kwargs, "O|OiO", const_cast<char**>(keywords),
+                                      &audio_object, &automation_object, &block_size, &keys_object)
+        || ! checkIdle(self)) {
+        return nullptr;
+    }
+    if (block_size < 1) {
+        PyErr_SetString(PyExc_ValueError, "block_size must be at least 1");
+        return nullptr;
+    }
+    AudioViews audio;
+    Automation automation;
+    std::vector<Key> keys;
+    if (! getAudioViews(audio, audio_object) || ! getAutomation(automation, automation_object, audio.num_frames)
+        || ! getKeys(keys, keys_object, audio.num_frames)) {
+        return nullptr;
+    }
+
+    splutter* engine = self->engine;
+    const int num_frames = (int) audio.num_frames;
+    size_t next_key = 0;
+    self->busy = true;
+    Py_BEGIN_ALLOW_THREADS
+    for (int start = 0; start < num_frames; start += block_size) {
+        const int length = num_frames - start < block_size ? num_frames - start : block_size;
+        for (int i = 0; i < automation.num_lanes; ++i) {
+            const AutomationLane& lane = automation.lanes[i];
+            splutter_set_param(engine, lane.param, lane.getValue(start + length - 1));
+        }
+        for (; next_key < keys.size() && keys[next_key].frame < start + length; ++next_key) {
+            const Key& key = keys[next_key];
+            splutter_key_event(engine, (int) (key.frame - start), key.note, key.down);
+        }
+        if (audio.sample_type == 'f') {
+            float* channels[SPLUTTER_MAX_CHANNELS];
+            for (int channel = 0; channel < audio.num_channels; ++channel) {
+                channels[channel] = reinterpret_cast<float*>(audio.channels[channel]) + start;
+            }
+            splutter_process(engine, channels, audio.num_channels, length);
+        } else {
+            double* channels[SPLUTTER_MAX_CHANNELS];
+            for (int channel = 0; channel < audio.num_channels; ++channel) {
+                channels[channel] = reinterpret_cast<double*>(audio.channels[channel]) + start;
+            }
+            splutter_process_double(engine, channels, audio.num_channels, length);
+        }
+    }
+    Py_END_ALLOW_THREADS
+    self->busy = false;
+    Py_RETURN_NONE;
+}
+
+static PyObject* Engine_get_latency(EngineObject* self, void*)
+{
+    return PyLong_FromLong(splutter_get_latency(self->engine));
+}
+
+static PyObject* Engine_get_sample_rate(EngineObject* self, void*)
+{
+    return PyFloat_FromDouble(self->sample_rate);
+}
+
+// The keyword methods take a third argument, so they go through a generic
+// function pointer on the way to PyCFunction, as METH_KEYWORDS expects.
+static PyMethodDef engine_methods[] = {
+    { "set_param", (PyCFunction) Engine_set_param, METH_VARARGS,
+      "set_param(param, value)\n\nSets a parameter, by name or index, in the plugin's units. Taken up at the next block." },
+    { "get_param", (PyCFunction) Engine_get_param, METH_O,
+      "get_param(param) -> float" },
+    { "set_eq_band", (PyCFunction) Engine_set_eq_band, METH_VARARGS,
+      "set_eq_band(band, freq, gain, q)\n\nBand 0 is a low shelf, 1 and 2 are peaks and 3 is a high shelf." },
+    { "set_transport", (PyCFunction) (void (*)(void)) Engine_set_transport, METH_VARARGS | METH_KEYWORDS,
+      "set_transport(bpm, ppq=0, playing=False)\n\nTempo and position for the synced rate and delay." },
+    { "switch_program", (PyCFunction) Engine_switch_program, METH_NOARGS,
+      "switch_program()\n\nJumps to the current parameters with a short crossfade instead of ramping." },
+    { "set_drawn_trajectory", (PyCFunction) Engine_set_drawn_trajectory, METH_O,
+      "set_drawn_trajectory(points)\n\nUp to 64 values from 0 to 1 across one grain, for the drawn shape." },
+    { "reset", (PyCFunction) (void (*)(void)) Engine_reset, METH_VARARGS | METH_KEYWORDS,
+      "reset(sample_rate=None)\n\nDefault parameters and silence, at a new sample rate or the same one." },
+    { "process", (PyCFunction) (void (*)(void)) Engine_process, METH_VARARGS | METH_KEYWORDS,
+      "process(audio, automation=None, block_size=512, keys=None)\n\n"
+      "Processes float32 or float64 audio in place, without the GIL: a (channels, frames)\n"
+      "array, a (frames,) array or a list of them. automation maps parameter names to a\n"
+      "value or an array with one value per frame. keys are (frame, note, down) tuples\n"
+      "in frame order." },
+    { nullptr, nullptr, 0, nullptr }
+};
+
+static PyGetSetDef engine_getters[] = {
+    { "latency", (getter) Engine_get_latency, nullptr, "Samples of latency the output has (the spectral engine's).", nullptr },
+    { "sample_rate", (getter) Engine_get_sample_rate, nullptr, "The sample rate the engine runs at.", nullptr },
+    { nullptr, nullptr, nullptr, nullptr, nullptr }
+};
+
+static PyType_Slot engine_slots[] = {
+    { Py_tp_doc, const_cast<char*>("Engine(sample_rate)\n\nOne instance of the pitch delay, used from one thread at a time.") },
+    { Py_tp_new, reinterpret_cast<void*>(Engine_new) },
+    { Py_tp_dealloc, reinterpret_cast<void*>(Engine_dealloc) },
+    { Py_tp_methods, engine_methods },
+    { Py_tp_getset, engine_getters },
+    { 0, nullptr }
+};
+
+static PyType_Spec engine_spec = {
+    "splutter.Engine",
+    sizeof(EngineObject),
+    0,
+    Py_TPFLAGS_DEFAULT,
+    engine_slots
+};
+
+//==============================================================================
+static struct PyModuleDef splutter_module = {
+    PyModuleDef_HEAD_INIT,
+    "splutter",
+    "The splutter pitch delay, processing buffers in place.",
+    -1,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr
+};
+
+PyMODINIT_FUNC PyInit_splutter(void)
+{
+    PyObject* engine_type = PyType_FromSpec(&engine_spec);
+    if (engine_type == nullptr) {
+        return nullptr;
+    }
+    PyObject* module = PyModule_Create(&splutter_module);
+    if (module == nullptr) {
+        Py_DECREF(engine_type);
+        return nullptr;
+    }
+    if (PyModule_AddObject(module, "Engine", engine_type) < 0) {
+        Py_DECREF(engine_type);
+        Py_DECREF(module);
+        return nullptr;
+    }
+    PyObject* names = PyTuple_New(SPLUTTER_NUM_PARAMS);
+    for (int i = 0; names != nullptr && i < SPLUTTER_NUM_PARAMS; ++i) {
+        PyTuple_SET_ITEM(names, i, PyUnicode_FromString(parameter_names[i].name));
+    }
+    if (names == nullptr
+        || PyModule_AddObject(module, "PARAMETERS", names) < 0
+        || PyModule_AddIntConstant(module, "API_VERSION", splutter_get_api_version()) < 0) {
+        Py_XDECREF(names);
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
+
+#endif
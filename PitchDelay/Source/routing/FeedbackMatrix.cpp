@@ -0,0 +1,35 @@
+/*
+  ==============================================================================
+
+    FeedbackMatrix.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "FeedbackMatrix.h"
+#include <algorithm> // min, max
+
+FeedbackMatrix<2> getStereoFeedbackMatrix(int mode, float width)
+{
+    FeedbackMatrix<2> matrix;
+    matrix.setIdentity();
+    if (mode == stereo_ping_pong) {
+        matrix.gains[0][0] = 0.0f;
+        matrix.gains[0][1] = 1.0f;
+        matrix.gains[1][0] = 1.0f;
+        matrix.gains[1][1] = 0.0f;
+    } else if (mode == stereo_mid_side) {
+        // Left stays, right flips: mid becomes side and side becomes mid.
+        matrix.gains[1][1] = -1.0f;
+    } else if (mode == stereo_width) {
+        width = std::min(std::max(width, 0.0f), max_feedback_width);
+        const float mid = width > 1.0f ? 1.0f / width : 1.0f;
+        const float side = std::min(width, 1.0f);
+        matrix.gains[0][0] = (mid + side) / 2;
+        matrix.gains[0][1] = (mid - side) / 2;
+        matrix.gains[1][0] = (mid - side) / 2;
+        matrix.gains[1][1] = (mid + side) / 2;
+    }
+    return matrix;
+}
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    FeedbackMatrix.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// How the channels' wet signals feed back into each other's delay history:
+// channel i's history takes the sum over j of gains[i][j] * wet[j]. The
+// identity keeps every channel to itself.
+//
+// Every preset is orthogonal or a pair of gains of at most 1 on mid and side,
+// so it never turns more signal around than the plain feedback does.
+template <int N>
+struct FeedbackMatrix {
+    float gains[N][N];
+
+    void setIdentity() {
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < N; ++j) {
+                gains[i][j] = i == j ? 1.0f : 0.0f;
+            }
+        }
+    }
+
+    bool isIdentity() const {
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < N; ++j) {
+                if (gains[i][j] != (i == j ? 1.0f : 0.0f)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool operator== (const FeedbackMatrix& other) const {
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < N; ++j) {
+                if (gains[i][j] != other.gains[i][j]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // out = (this + amount * step) * in, for one frame. The loops have fixed
+    // bounds, so they unroll into packed multiplies of the whole matrix.
+    inline void applyRamped(const FeedbackMatrix& step, float amount, const float* in, float* out) const {
+        float products[N][N];
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < N; ++j) {
+                products[i][j] = (gains[i][j] + amount * step.gains[i][j]) * in[j];
+            }
+        }
+        for (int i = 0; i < N; ++i) {
+            out[i] = 0;
+            for (int j = 0; j < N; ++j) {
+                out[i] += products[i][j];
+            }
+        }
+    }
+};
+
+// Stereo feedback routings.
+//
+// Ping-pong swaps the channels on every trip round the loop. Mid/side swaps
+// mid and side instead, so a centred echo comes back wide and a wide one
+// comes back centred. Width scales the side against the mid on every trip:
+// below 1 the echoes close in towards the centre, above 1 they spread out,
+// with the louder of the two held at 1.
+enum StereoFeedback { stereo_normal = 0, stereo_ping_pong, stereo_mid_side, stereo_width };
+#define NUM_STEREO_FEEDBACK_MODES 4
+const float max_feedback_width = 2.0;
+
+FeedbackMatrix<2> getStereoFeedbackMatrix(int mode, float width);
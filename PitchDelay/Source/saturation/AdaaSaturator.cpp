@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    AdaaSaturator.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "AdaaSaturator.h"
+#include <algorithm> // min, max
+
+AdaaSaturator::AdaaSaturator(): order(1), drive(1), inv_drive(1)
+{
+    reset();
+}
+
+void AdaaSaturator::setOrder(int newOrder)
+{
+    order = std::min(std::max(newOrder, 1), 2);
+    // The first order keeps x2 up to date too, so the second can take over
+    // from it without a jump.
+    average1_prev = average1(x1, x2);
+}
+
+void AdaaSaturator::setDrive(float gain)
+{
+    double new_drive = std::max((double) gain, 1.0);
+    if (new_drive == drive) {
+        return;
+    }
+    // The history is kept with the drive applied, so it moves to the new one.
+    double rescale = new_drive / drive;
+    x1 *= rescale;
+    x2 *= rescale;
+    average1_prev = average1(x1, x2);
+    drive = new_drive;
+    inv_drive = 1.0 / new_drive;
+}
+
+void AdaaSaturator::reset()
+{
+    x1 = 0;
+    x2 = 0;
+    average1_prev = 0;
+}
+
+void AdaaSaturator::processBlock(const float* input, float* output, int numSamples)
+{
+    // Each chunk's inputs sit on the stack after the two before them. The
+    // first pass takes every sample the usual way, dividing by 1 where the
+    // inputs are too close, with selects rather than branches so the compiler
+    // can run it several samples at a time. The second pass redoes those few
+    // samples the way tick does.
+    const int chunk = 64;
+    double xs[chunk + 2];
+    double averages[chunk + 1];
+    double ys[chunk];
+    for (int start = 0; start < numSamples; start += chunk) {
+        const int n = std::min(chunk, numSamples - start);
+        xs[0] = x2;
+        xs[1] = x1;
+        for (int i = 0; i < n; ++i) {
+            xs[i + 2] = input[start + i] * drive;
+        }
+        
+        if (order == 1) {
+            for (int i = 0; i < n; ++i) {
+                double difference = xs[i + 2] - xs[i + 1];
+                double divisor = fabs(difference) < adaa::tolerance ? 1.0 : difference;
+                ys[i] = (antiderivative1(xs[i + 2]) - antiderivative1(xs[i + 1])) / divisor;
+            }
+            for (int i = 0; i < n; ++i) {
+                if (fabs(xs[i + 2] - xs[i + 1]) < adaa::tolerance) {
+                    ys[i] = curve(0.5 * (xs[i + 2] + xs[i + 1]));
+                }
+            }
+        } else {
+            averages[0] = average1_prev;
+            for (int i = 0; i < n; ++i) {
+                averages[i + 1] = average1(xs[i + 2], xs[i + 1]);
+            }
+            for (int i = 0; i < n; ++i) {
+                double difference = xs[i + 2] - xs[i];
+                double divisor = fabs(difference) < adaa::tolerance ? 1.0 : difference;
+                ys[i] = 2.0 * (averages[i + 1] - averages[i]) / divisor;
+            }
+            for (int i = 0; i < n; ++i) {
+                if (fabs(xs[i + 2] - xs[i]) < adaa::tolerance) {
+                    ys[i] = getCoincidentAverage(xs[i + 2], xs[i + 1], xs[i]);
+                }
+            }
+            average1_prev = averages[n];
+        }
+        
+        for (int i = 0; i < n; ++i) {
+            output[start + i] = (float) (ys[i] * inv_drive);
+        }
+        x2 = xs[n];
+        x1 = xs[n + 1];
+    }
+}
@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+    AdaaSaturator.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <math.h> // fabs
+
+// Soft clipper for the feedback loop, antialiased by antiderivatives (ADAA).
+//
+// The curve is x - 4/27 x^3 up to |x| = 1.5, where it flattens out at 1, so
+// quiet signals pass at unity gain and nothing gets past 1. Drive scales the
+// input up and the output back down by the same amount: it sets how loud a
+// signal can get through, not how loud it comes out.
+//
+// Instead of the curve itself, the first-order form outputs the average of the
+// curve over the straight line between the last two inputs, which is the
+// difference of its antiderivative over the difference of the inputs. That
+// takes out most of the aliasing that clipping at the base rate would fold
+// back, and the second-order form, which averages over the last three inputs,
+// takes out more. They delay the signal by half a sample and one sample. When
+// the inputs are too close for the division to be accurate, the curve is
+// evaluated at their midpoint instead.
+//
+// The output only depends on the inputs, never on earlier outputs, so a block
+// can be worked out all at once (processBlock), and the compiler can run it
+// several samples at a time.
+class AdaaSaturator
+{
+public:
+    AdaaSaturator();
+
+    // 1 or 2.
+    void setOrder(int order);
+    int getOrder() const { return order; }
+    // Linear gain, at least 1.
+    void setDrive(float gain);
+
+    void reset();
+
+    inline float tick(float input);
+    void processBlock(const float* input, float* output, int numSamples);
+
+    // The curve, scaled to the knee, and its first and second antiderivatives.
+    static inline double curve(double x);
+    static inline double antiderivative1(double x);
+    static inline double antiderivative2(double x);
+
+private:
+    // The average of antiderivative1 between a and b.
+    static inline double average1(double a, double b);
+    // The second-order output when the inputs a and b, either side of m,
+    // are too close to divide by their difference.
+    static inline double getCoincidentAverage(double a, double m, double b);
+
+    int order;
+    double drive;
+    double inv_drive;
+    // The last two inputs, with the drive applied, and average1 between them.
+    // Only the second order uses x2 and average1_prev.
+    double x1, x2;
+    double average1_prev;
+};
+
+namespace adaa {
+    const double knee = 1.5;
+    const double cubic = 4.0 / 27.0;
+    // Below this difference between inputs, averages are taken at the midpoint.
+    const double tolerance = 1e-5;
+    // antiderivative1 and antiderivative2 at the knee.
+    const double knee_integral1 = 0.9375;
+    const double knee_integral2 = 0.50625;
+}
+
+// The drive control's range, in dB.
+const float max_saturation_drive = 24.0;
+
+inline double AdaaSaturator::curve(double x)
+{
+    double clamped = x < -adaa::knee ? -adaa::knee : (x > adaa::knee ? adaa::knee : x);
+    return clamped - adaa::cubic * clamped * clamped * clamped;
+}
+
+inline double AdaaSaturator::antiderivative1(double x)
+{
+    double ax = fabs(x);
+    double x2 = x * x;
+    double inner = x2 * (0.5 - 0.25 * adaa::cubic * x2);
+    double outer = ax - adaa::knee + adaa::knee_integral1;
+    return ax <= adaa::knee ? inner : outer;
+}
+
+inline double AdaaSaturator::antiderivative2(double x)
+{
+    // Odd, since antiderivative1 is even.
+    double ax = fabs(x);
+    double x2 = x * x;
+    double inner = x * x2 * (1.0 / 6.0 - 0.05 * adaa::cubic * x2);
+    double past = ax - adaa::knee;
+    double outer = adaa::knee_integral2 + adaa::knee_integral1 * past + 0.5 * past * past;
+    return ax <= adaa::knee ? inner : (x < 0 ? -outer : outer);
+}
+
+inline double AdaaSaturator::average1(double a, double b)
+{
+    double difference = a - b;
+    bool close = fabs(difference) < adaa::tolerance;
+    double exact = (antiderivative2(a) - antiderivative2(b)) / (close ? 1.0 : difference);
+    return close ? antiderivative1(0.5 * (a + b)) : exact;
+}
+
+inline double AdaaSaturator::getCoincidentAverage(double a, double m, double b)
+{
+    // The ends coincide: average over the two halves through m.
+    double middle = 0.5 * (a + b);
+    double to_middle = middle - m;
+    if (fabs(to_middle) < adaa::tolerance) {
+        return curve(0.5 * (middle + m));
+    }
+    return 2.0 / to_middle * (antiderivative1(middle) + (antiderivative2(m) - antiderivative2(middle)) / to_middle);
+}
+
+inline float AdaaSaturator::tick(float input)
+{
+    double x = input * drive;
+    double y;
+    if (order == 1) {
+        double difference = x - x1;
+        if (fabs(difference) < adaa::tolerance) {
+            y = curve(0.5 * (x + x1));
+        } else {
+            y = (antiderivative1(x) - antiderivative1(x1)) / difference;
+        }
+    } else {
+        double average = average1(x, x1);
+        double difference = x - x2;
+        if (fabs(difference) < adaa::tolerance) {
+            y = getCoincidentAverage(x, x1, x2);
+        } else {
+            y = 2.0 * (average - average1_prev) / difference;
+        }
+        average1_prev = average;
+    }
+    x2 = x1;
+    x1 = x;
+    return (float) (y * inv_drive);
+}
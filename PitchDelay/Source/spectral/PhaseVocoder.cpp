@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+    PhaseVocoder.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "PhaseVocoder.h"
+#include <math.h>
+#include <string.h> // memset, memcpy
+#include <algorithm> // min, max
+
+// Hann windows on both sides, four frames deep, add up to 1.5.
+static const float overlap_gain = 1.0f / 1.5f;
+// Quieter peaks than this are left where they are, as part of a louder
+// peak's region.
+static const float peak_floor = 1e-10f;
+
+PhaseVocoder::PhaseVocoder()
+    : fft(fft_order),
+      pitch_ratio(1.0f)
+{
+    // Analysis, FFT passes, shift, inverse passes, overlap-add.
+    num_units = 2 * fft.getNumPasses() + 5;
+    for (int i = 0; i < frame_size; ++i) {
+        window[i] = 0.5 - 0.5 * cos(2 * M_PI * i / frame_size);
+    }
+    reset();
+}
+
+void PhaseVocoder::reset()
+{
+    units_done = 0;
+    hop_pos = 0;
+    write_pos = 0;
+    memset(input_ring, 0, sizeof(input_ring));
+    memset(output_ring, 0, sizeof(output_ring));
+    memset(last_phase, 0, sizeof(last_phase));
+    memset(synthesis_phase, 0, sizeof(synthesis_phase));
+}
+
+void PhaseVocoder::copyFrom(const PhaseVocoder& other)
+{
+    fft.copyWorkFrom(other.fft);
+    num_units = other.num_units;
+    units_done = other.units_done;
+    hop_pos = other.hop_pos;
+    write_pos = other.write_pos;
+    pitch_ratio = other.pitch_ratio;
+    memcpy(input_ring, other.input_ring, sizeof(input_ring));
+    memcpy(output_ring, other.output_ring, sizeof(output_ring));
+    memcpy(frame, other.frame, sizeof(frame));
+    memcpy(spectrum_re, other.spectrum_re, sizeof(spectrum_re));
+    memcpy(spectrum_im, other.spectrum_im, sizeof(spectrum_im));
+    memcpy(power, other.power, sizeof(power));
+    memcpy(phase, other.phase, sizeof(phase));
+    memcpy(last_phase, other.last_phase, sizeof(last_phase));
+    memcpy(synthesis_phase, other.synthesis_phase, sizeof(synthesis_phase));
+    memcpy(shifted_re, other.shifted_re, sizeof(shifted_re));
+    memcpy(shifted_im, other.shifted_im, sizeof(shifted_im));
+}
+
+void PhaseVocoder::runWorkUnit(int unit)
+{
+    const int passes = fft.getNumPasses();
+    if (unit == 0) {
+        // The hop that just ended completes the frame.
+        const unsigned int start = write_pos - hop_pos - frame_size;
+        for (int i = 0; i < frame_size; ++i) {
+            frame[i] = input_ring[(start + i) & ring_mask] * window[i];
+        }
+        fft.beginForward(frame);
+    } else if (unit <= passes) {
+        fft.pass(unit - 1);
+    } else if (unit == passes + 1) {
+        fft.finishForward(spectrum_re, spectrum_im);
+        analyse();
+    } else if (unit == passes + 2) {
+        shiftSpectrum();
+    } else if (unit == passes + 3) {
+        fft.beginInverse(shifted_re, shifted_im);
+    } else if (unit <= 2 * passes + 3) {
+        fft.pass(unit - passes - 4);
+    } else {
+        fft.finishInverse(frame);
+        overlapAdd();
+    }
+}
+
+void PhaseVocoder::analyse()
+{
+    for (int k = 0; k < num_bins; ++k) {
+        power[k] = spectrum_re[k] * spectrum_re[k] + spectrum_im[k] * spectrum_im[k];
+        phase[k] = atan2(spectrum_im[k], spectrum_re[k]);
+    }
+}
+
+void PhaseVocoder::shiftSpectrum()
+{
+    memset(shifted_re, 0, sizeof(shifted_re));
+    memset(shifted_im, 0, sizeof(shifted_im));
+    
+    const float expected_per_bin = 2 * M_PI * hop_size / frame_size;
+    
+    // Walk the peaks in order; each one owns the bins from halfway to the
+    // previous peak up to halfway to the next.
+    int region_start = 0;
+    int peak = -1;
+    for (int k = 0; k < num_bins; ++k) {
+        bool is_peak = k >= 2 && k < num_bins - 2 && power[k] > peak_floor
+            && power[k] > power[k - 1] && power[k] > power[k - 2]
+            && power[k] >= power[k + 1] && power[k] >= power[k + 2];
+        if (! is_peak && k != num_bins - 1) {
+            continue;
+        }
+        int next_peak = is_peak ? k : num_bins;
+        if (peak >= 0) {
+            int region_end = is_peak ? (peak + next_peak + 1) / 2 : num_bins;
+            
+            // The peak's true frequency from how far its phase moved over the
+            // hop, and the phase it needs at its new bin to carry on from the
+            // last frame's output there.
+            int target = (int) (peak * pitch_ratio + 0.5f);
+            if (target < num_bins) {
+                float deviation = phase[peak] - last_phase[peak] - expected_per_bin * peak;
+                deviation -= 2 * M_PI * floor(deviation / (2 * M_PI) + 0.5);
+                float advance = (expected_per_bin * peak + deviation) * pitch_ratio;
+                float new_phase = synthesis_phase[target] + advance;
+                float rotation = new_phase - phase[peak];
+                const float rot_re = cos(rotation);
+                const float rot_im = sin(rotation);
+                
+                const int shift = target - peak;
+                const int from = std::max(region_start, -shift);
+                const int to = std::min(region_end, num_bins - shift);
+                for (int bin = from; bin < to; ++bin) {
+                    shifted_re[bin + shift] += spectrum_re[bin] * rot_re - spectrum_im[bin] * rot_im;
+                    shifted_im[bin + shift] += spectrum_re[bin] * rot_im + spectrum_im[bin] * rot_re;
+                }
+                new_phase -= 2 * M_PI * floor(new_phase / (2 * M_PI));
+                synthesis_phase[target] = new_phase;
+            }
+            region_start = region_end;
+        }
+        peak = next_peak;
+    }
+    
+    memcpy(last_phase, phase, sizeof(last_phase));
+}
+
+void PhaseVocoder::overlapAdd()
+{
+    const unsigned int start = write_pos - hop_pos - frame_size;
+    for (int i = 0; i < frame_size; ++i) {
+        output_ring[(start + i) & ring_mask] += frame[i] * window[i] * overlap_gain;
+    }
+}
@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    PhaseVocoder.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "RealFFT.h"
+
+// Streaming pitch shifter for one channel, one sample in and one out.
+//
+// Frames of frame_size samples are taken every hop_size samples, shifted in
+// frequency with phase locking, and added back together. Each peak in the
+// spectrum takes its neighbouring bins along with it (up to halfway to the
+// next peak) with the same phase rotation, which keeps partials from
+// smearing.
+//
+// A frame is not processed all at once when its last sample arrives. The
+// work (windowing, each FFT pass, the shift, each inverse pass, the overlap
+// add) is split into units, and tick() runs a share of them on every sample of
+// the following hop. The cost per host block is then in proportion to its
+// length whatever the block size, at the price of one extra hop of latency.
+
+class PhaseVocoder
+{
+public:
+    static const int fft_order = 11;
+    static const int frame_size = 1 << fft_order;
+    static const int hop_size = frame_size / 4;
+    static const int num_bins = frame_size / 2 + 1;
+    // Samples from a sample going in to it coming back out.
+    static const int latency = frame_size + hop_size;
+
+    PhaseVocoder();
+
+    // Clears all history, as if nothing had been played.
+    void reset();
+
+    // Carries on from where another vocoder is, frame in progress and all.
+    // Nothing is allocated.
+    void copyFrom(const PhaseVocoder& other);
+
+    // Read at the start of each frame's shift.
+    void setPitchRatio(float ratio) { pitch_ratio = ratio; }
+
+    inline float tick(float input);
+
+private:
+    static const int ring_size = 2 * frame_size; // power of two, holds a frame plus a hop
+    static const int ring_mask = ring_size - 1;
+
+    void runWorkUnit(int unit);
+    void analyse();
+    void shiftSpectrum();
+    void overlapAdd();
+
+    RealFFT fft;
+    int num_units;
+    int units_done;
+    int hop_pos;
+    unsigned int write_pos; // counts samples, wraps with the ring mask
+
+    float pitch_ratio;
+
+    float input_ring[ring_size];
+    float output_ring[ring_size];
+    float frame[frame_size];
+    float window[frame_size];
+
+    float spectrum_re[num_bins], spectrum_im[num_bins];
+    float power[num_bins];
+    float phase[num_bins];
+    float last_phase[num_bins];       // analysis phase of the previous frame
+    float synthesis_phase[num_bins];  // output phase of the previous frame
+    float shifted_re[num_bins], shifted_im[num_bins];
+};
+
+inline float PhaseVocoder::tick(float input)
+{
+    input_ring[write_pos & ring_mask] = input;
+    
+    // Enough units that the frame is done by the end of the hop.
+    const int units_due = ((hop_pos + 1) * num_units + hop_size - 1) / hop_size;
+    while (units_done < units_due) {
+        runWorkUnit(units_done++);
+    }
+    
+    float* out = &output_ring[(write_pos - latency) & ring_mask];
+    const float output = *out;
+    *out = 0;
+    
+    write_pos++;
+    if (++hop_pos == hop_size) {
+        hop_pos = 0;
+        units_done = 0;
+    }
+    return output;
+}
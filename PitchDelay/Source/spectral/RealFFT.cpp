@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+    RealFFT.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "RealFFT.h"
+#include <math.h>
+#include <algorithm> // copy
+
+RealFFT::RealFFT(int order)
+    : size(1 << order),
+      half(1 << (order - 1)),
+      num_passes(order - 1),
+      bit_reverse(half),
+      pass_cos(half), pass_sin(half),
+      split_cos(half + 1), split_sin(half + 1),
+      work_re(half), work_im(half)
+{
+    for (int i = 0; i < half; ++i) {
+        int reversed = 0;
+        for (int bit = 0; bit < num_passes; ++bit) {
+            reversed |= ((i >> bit) & 1) << (num_passes - 1 - bit);
+        }
+        bit_reverse[i] = reversed;
+    }
+    
+    for (int stage = 0; stage < num_passes; ++stage) {
+        const int span = 2 << stage;
+        float* c = &pass_cos[(1 << stage) - 1];
+        float* s = &pass_sin[(1 << stage) - 1];
+        for (int k = 0; k < span / 2; ++k) {
+            c[k] = cos(2.0 * M_PI * k / span);
+            s[k] = -sin(2.0 * M_PI * k / span);
+        }
+    }
+    
+    for (int k = 0; k <= half; ++k) {
+        split_cos[k] = cos(2.0 * M_PI * k / size);
+        split_sin[k] = -sin(2.0 * M_PI * k / size);
+    }
+}
+
+void RealFFT::beginForward(const float* input)
+{
+    // Even samples are the real part, odd samples the imaginary part.
+    for (int i = 0; i < half; ++i) {
+        work_re[bit_reverse[i]] = input[2 * i];
+        work_im[bit_reverse[i]] = input[2 * i + 1];
+    }
+}
+
+void RealFFT::pass(int stage)
+{
+    const int half_span = 1 << stage;
+    const float* c = &pass_cos[half_span - 1];
+    const float* s = &pass_sin[half_span - 1];
+    float* re = work_re.data();
+    float* im = work_im.data();
+    
+    for (int start = 0; start < half; start += 2 * half_span) {
+        float* a_re = re + start;
+        float* a_im = im + start;
+        float* b_re = a_re + half_span;
+        float* b_im = a_im + half_span;
+        for (int k = 0; k < half_span; ++k) {
+            float t_re = b_re[k] * c[k] - b_im[k] * s[k];
+            float t_im = b_re[k] * s[k] + b_im[k] * c[k];
+            b_re[k] = a_re[k] - t_re;
+            b_im[k] = a_im[k] - t_im;
+            a_re[k] += t_re;
+            a_im[k] += t_im;
+        }
+    }
+}
+
+void RealFFT::finishForward(float* re, float* im)
+{
+    // X[k] = (Z[k] + conj Z[N/2-k]) / 2 + W^k (Z[k] - conj Z[N/2-k]) / 2i
+    for (int k = 0; k <= half; ++k) {
+        const int a = k == half ? 0 : k;
+        const int b = k == 0 ? 0 : half - k;
+        float even_re = 0.5f * (work_re[a] + work_re[b]);
+        float even_im = 0.5f * (work_im[a] - work_im[b]);
+        float odd_re = 0.5f * (work_im[a] + work_im[b]);
+        float odd_im = -0.5f * (work_re[a] - work_re[b]);
+        re[k] = even_re + split_cos[k] * odd_re - split_sin[k] * odd_im;
+        im[k] = even_im + split_cos[k] * odd_im + split_sin[k] * odd_re;
+    }
+}
+
+void RealFFT::beginInverse(const float* re, const float* im)
+{
+    // Rebuild the packed transform, conjugated so the forward passes run it
+    // backwards.
+    for (int k = 0; k < half; ++k) {
+        const int b = half - k;
+        float even_re = 0.5f * (re[k] + re[b]);
+        float even_im = 0.5f * (im[k] - im[b]);
+        float diff_re = 0.5f * (re[k] - re[b]);
+        float diff_im = 0.5f * (im[k] + im[b]);
+        // odd = diff * conj(W^k)
+        float odd_re = diff_re * split_cos[k] + diff_im * split_sin[k];
+        float odd_im = diff_im * split_cos[k] - diff_re * split_sin[k];
+        const int i = bit_reverse[k];
+        work_re[i] = even_re - odd_im;
+        work_im[i] = -(even_im + odd_re);
+    }
+}
+
+void RealFFT::finishInverse(float* output)
+{
+    const float scale = 1.0f / half;
+    for (int i = 0; i < half; ++i) {
+        output[2 * i] = work_re[i] * scale;
+        output[2 * i + 1] = -work_im[i] * scale;
+    }
+}
+
+void RealFFT::forward(const float* input, float* re, float* im)
+{
+    beginForward(input);
+    for (int stage = 0; stage < num_passes; ++stage) {
+        pass(stage);
+    }
+    finishForward(re, im);
+}
+
+void RealFFT::inverse(const float* re, const float* im, float* output)
+{
+    beginInverse(re, im);
+    for (int stage = 0; stage < num_passes; ++stage) {
+        pass(stage);
+    }
+    finishInverse(output);
+}
+
+void RealFFT::copyWorkFrom(const RealFFT& other)
+{
+    std::copy(other.work_re.begin(), other.work_re.end(), work_re.begin());
+    std::copy(other.work_im.begin(), other.work_im.end(), work_im.begin());
+}
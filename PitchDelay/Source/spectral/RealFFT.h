@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    RealFFT.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <vector>
+
+// Power-of-two FFT of a real signal, planned once for a fixed size.
+//
+// The N real samples are packed into N/2 complex points, transformed with
+// iterative radix-2 passes, and split back into the N/2 + 1 bins of the real
+// spectrum. The bit reversal order and the twiddles are worked out in the
+// constructor; each pass reads its own twiddles from one contiguous run, so
+// the inner loops walk memory in order.
+//
+// The passes are exposed one at a time so the phase vocoder can spread a
+// transform over several calls. forward() and inverse() do the whole thing.
+
+class RealFFT
+{
+public:
+    explicit RealFFT(int order);
+
+    int getSize() const { return size; }
+    int getNumBins() const { return half + 1; }
+    int getNumPasses() const { return num_passes; }
+
+    // Forward: beginForward, every pass in order, then finishForward.
+    void beginForward(const float* input);
+    void finishForward(float* re, float* im);
+
+    // Inverse: beginInverse, every pass in order, then finishInverse. The
+    // output is scaled so that inverse(forward(x)) == x.
+    void beginInverse(const float* re, const float* im);
+    void finishInverse(float* output);
+
+    // One radix-2 pass over the packed complex points.
+    void pass(int stage);
+
+    void forward(const float* input, float* re, float* im);
+    void inverse(const float* re, const float* im, float* output);
+
+    // Takes over a transform in progress from another FFT of the same size.
+    void copyWorkFrom(const RealFFT& other);
+
+private:
+    int size;       // real points
+    int half;       // complex points
+    int num_passes;
+
+    std::vector<int> bit_reverse;
+    // Twiddles for pass s start at (1 << s) - 1.
+    std::vector<float> pass_cos, pass_sin;
+    // Twiddles for splitting the packed transform into the real spectrum.
+    std::vector<float> split_cos, split_sin;
+
+    std::vector<float> work_re, work_im;
+};
@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+    StateCodec.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "StateCodec.h"
+#include <cstring>
+
+// Reflected CRC-32 (the zlib polynomial), one table lookup per byte.
+struct CrcTable {
+    uint32_t entries[256];
+
+    CrcTable() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+            }
+            entries[i] = crc;
+        }
+    }
+};
+static const CrcTable crc_table;
+
+uint32_t state_codec::crc32(const uint8_t* data, int size)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    for (int i = 0; i < size; ++i) {
+        crc = crc_table.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+static void putU16(uint8_t* out, uint16_t value)
+{
+    out[0] = (uint8_t) value;
+    out[1] = (uint8_t) (value >> 8);
+}
+
+static void putU32(uint8_t* out, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) {
+        out[i] = (uint8_t) (value >> (8 * i));
+    }
+}
+
+static uint16_t getU16(const uint8_t* in)
+{
+    return (uint16_t) (in[0] | (in[1] << 8));
+}
+
+static uint32_t getU32(const uint8_t* in)
+{
+    return (uint32_t) in[0] | ((uint32_t) in[1] << 8) | ((uint32_t) in[2] << 16) | ((uint32_t) in[3] << 24);
+}
+
+//==============================================================================
+StateWriter::StateWriter(): size(state_codec::header_size), count(0)
+{
+    std::memcpy(data, state_codec::magic, 4);
+    putU16(data + 4, state_codec::version);
+}
+
+void StateWriter::addFloat(uint16_t tag, float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, 4);
+    addField(tag, bits);
+}
+
+void StateWriter::addInt(uint16_t tag, int32_t value)
+{
+    addField(tag, (uint32_t) value);
+}
+
+void StateWriter::addFloats(uint16_t tag, const float* values, int count)
+{
+    if (! addFieldHeader(tag, 4 * count)) {
+        return;
+    }
+    for (int i = 0; i < count; ++i) {
+        uint32_t bits;
+        std::memcpy(&bits, values + i, 4);
+        putU32(data + size, bits);
+        size += 4;
+    }
+}
+
+bool StateWriter::addFieldHeader(uint16_t tag, int payload_size)
+{
+    // The buffer is sized for every field this build writes, with room to spare.
+    if (size + state_codec::field_header_size + payload_size > state_codec::max_state_size) {
+        return false;
+    }
+    putU16(data + size, tag);
+    putU16(data + size + 2, (uint16_t) payload_size);
+    size += state_codec::field_header_size;
+    ++count;
+    return true;
+}
+
+void StateWriter::addField(uint16_t tag, uint32_t bits)
+{
+    if (addFieldHeader(tag, 4)) {
+        putU32(data + size, bits);
+        size += 4;
+    }
+}
+
+const uint8_t* StateWriter::finish()
+{
+    putU16(data + 6, (uint16_t) count);
+    putU32(data + 8, state_codec::crc32(data + state_codec::header_size, size - state_codec::header_size));
+    return data;
+}
+
+//==============================================================================
+StateReader::StateReader(): fields(nullptr), fields_left(0), position(0), tag(0), payload(nullptr), payload_size(0)
+{
+}
+
+bool StateReader::open(const void* data, int size)
+{
+    fields = nullptr;
+    fields_left = 0;
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    if (bytes == nullptr || size < state_codec::header_size
+        || std::memcmp(bytes, state_codec::magic, 4) != 0
+        || getU16(bytes + 4) > state_codec::version) {
+        return false;
+    }
+    const int count = getU16(bytes + 6);
+    const uint8_t* body = bytes + state_codec::header_size;
+    const int body_size = size - state_codec::header_size;
+    if (state_codec::crc32(body, body_size) != getU32(bytes + 8)) {
+        return false;
+    }
+
+    // Check that every field fits before handing any of them out, so a
+    // caller never applies half of a damaged state.
+    int offset = 0;
+    for (int i = 0; i < count; ++i) {
+        if (offset + state_codec::field_header_size > body_size) {
+            return false;
+        }
+        offset += state_codec::field_header_size + getU16(body + offset + 2);
+        if (offset > body_size) {
+            return false;
+        }
+    }
+
+    fields = body;
+    fields_left = count;
+    position = 0;
+    return true;
+}
+
+bool StateReader::next()
+{
+    if (fields_left == 0) {
+        return false;
+    }
+    tag = getU16(fields + position);
+    payload_size = getU16(fields + position + 2);
+    payload = fields + position + state_codec::field_header_size;
+    position += state_codec::field_header_size + payload_size;
+    --fields_left;
+    return true;
+}
+
+bool StateReader::getBits(uint32_t& bits) const
+{
+    if (payload_size != 4) {
+        return false;
+    }
+    bits = getU32(payload);
+    return true;
+}
+
+bool StateReader::getFloat(float& value) const
+{
+    uint32_t bits;
+    if (! getBits(bits)) {
+        return false;
+    }
+    std::memcpy(&value, &bits, 4);
+    return true;
+}
+
+bool StateReader::getInt(int32_t& value) const
+{
+    uint32_t bits;
+    if (! getBits(bits)) {
+        return false;
+    }
+    value = (int32_t) bits;
+    return true;
+}
+
+int StateReader::getFloats(float* values, int maxCount) const
+{
+    if (payload_size % 4 != 0 || payload_size / 4 > maxCount) {
+        return -1;
+    }
+    for (int i = 0; i < payload_size / 4; ++i) {
+        uint32_t bits = getU32(payload + 4 * i);
+        std::memcpy(values + i, &bits, 4);
+    }
+    return payload_size / 4;
+}
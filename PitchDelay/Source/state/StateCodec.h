@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    StateCodec.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+// Compact binary plugin state.
+//
+// Everything is little endian, whatever the machine:
+//
+//   magic     4 bytes   "SPLT"
+//   version   u16       layout of the header and fields, not of the plugin
+//   count     u16       number of fields
+//   checksum  u32       CRC-32 of the field bytes
+//   fields    count x { tag u16, length u16, length bytes of payload }
+//
+// Every field carries its own length, so a reader skips tags it doesn't know
+// and a state saved by a newer build still loads into an older one. Tags are
+// never renumbered or reused.
+namespace state_codec {
+    const uint8_t magic[4] = { 'S', 'P', 'L', 'T' };
+    const uint16_t version = 1;
+    const int header_size = 12;
+    const int field_header_size = 4;
+    const int max_state_size = 1024;
+
+    uint32_t crc32(const uint8_t* data, int size);
+}
+
+// Builds a state in a fixed buffer, so saving never touches the heap until
+// the host's block is filled.
+class StateWriter
+{
+public:
+    StateWriter();
+
+    void addFloat(uint16_t tag, float value);
+    void addInt(uint16_t tag, int32_t value);
+    void addFloats(uint16_t tag, const float* values, int count);
+
+    // Fills in the field count and checksum. Call once, after the last field.
+    const uint8_t* finish();
+    int getSize() const { return size; }
+
+private:
+    // False, and nothing written, if the field doesn't fit.
+    bool addFieldHeader(uint16_t tag, int payload_size);
+    void addField(uint16_t tag, uint32_t bits);
+
+    uint8_t data[state_codec::max_state_size];
+    int size;
+    int count;
+};
+
+// Walks the fields of a state in place, without copying or allocating.
+//
+//     StateReader reader;
+//     if (reader.open(data, size)) {
+//         while (reader.next()) { ... reader.getTag() ... }
+//     }
+class StateReader
+{
+public:
+    StateReader();
+
+    // False if the block is not a state this build can read: wrong magic, a
+    // newer layout version, a truncated field or a checksum mismatch. Nothing
+    // can be read from a block that fails to open.
+    bool open(const void* data, int size);
+
+    // Moves to the next field, returning false after the last one.
+    bool next();
+
+    uint16_t getTag() const { return tag; }
+
+    // False if the current field's payload isn't the expected size.
+    bool getFloat(float& value) const;
+    bool getInt(int32_t& value) const;
+    // The number of floats copied out, or -1 if the payload isn't a whole
+    // number of them or holds more than maxCount.
+    int getFloats(float* values, int maxCount) const;
+
+private:
+    bool getBits(uint32_t& bits) const;
+
+    const uint8_t* fields;
+    int fields_left;
+    int position;
+    uint16_t tag;
+    const uint8_t* payload;
+    int payload_size;
+};
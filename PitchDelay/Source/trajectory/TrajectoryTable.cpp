@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    TrajectoryTable.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "TrajectoryTable.h"
+#include <math.h> // cos
+#include <stdint.h> // uint32_t
+#include <algorithm> // min, max
+
+static const double pi = 3.14159265358979;
+
+void TrajectoryTable::setSawtooth()
+{
+    for (int i = 0; i <= size; ++i) {
+        values[i] = i / (float) size;
+    }
+    setEndSlope();
+}
+
+void TrajectoryTable::setTriangle()
+{
+    for (int i = 0; i <= size; ++i) {
+        values[i] = 1.0f - fabs(2.0f * i / (float) size - 1.0f);
+    }
+    setEndSlope();
+}
+
+void TrajectoryTable::setStepped()
+{
+    const int steps = 4;
+    const double ramp = 0.1; // of each step
+    for (int i = 0; i <= size; ++i) {
+        double position = std::min(i * steps / (double) size, steps - 1e-9);
+        int step = (int) position;
+        double through = position - step;
+        // The last step holds, so the grain ends where the next one's
+        // crossfade picks it up.
+        double level = step;
+        if (through > 1 - ramp && step < steps - 1) {
+            level += 0.5 - 0.5 * cos(pi * (through - (1 - ramp)) / ramp);
+        }
+        values[i] = (float) (level / (steps - 1));
+    }
+    setEndSlope();
+}
+
+void TrajectoryTable::setRandomWalk()
+{
+    // Cosine interpolated between the points of a walk of random steps.
+    const int points = 16;
+    double walk[points + 1];
+    uint32_t seed = 12345;
+    walk[0] = 0;
+    for (int point = 1; point <= points; ++point) {
+        seed = seed * 1664525u + 1013904223u;
+        walk[point] = walk[point - 1] + (seed >> 8) / 16777216.0 - 0.5;
+    }
+    double lowest = *std::min_element(walk, walk + points + 1);
+    double highest = *std::max_element(walk, walk + points + 1);
+    for (int i = 0; i <= size; ++i) {
+        double position = std::min(i * points / (double) size, points - 1e-9);
+        int point = (int) position;
+        double blend = 0.5 - 0.5 * cos(pi * (position - point));
+        double level = walk[point] + blend * (walk[point + 1] - walk[point]);
+        values[i] = (float) ((level - lowest) / (highest - lowest));
+    }
+    setEndSlope();
+}
+
+void TrajectoryTable::setFromPoints(const float* points, int numPoints)
+{
+    if (numPoints < 2) {
+        float level = numPoints == 1 ? std::min(std::max(points[0], 0.0f), 1.0f) : 0.0f;
+        std::fill(values, values + size + 1, level);
+        setEndSlope();
+        return;
+    }
+    for (int i = 0; i <= size; ++i) {
+        double position = i * (numPoints - 1) / (double) size;
+        int point = std::min((int) position, numPoints - 2);
+        float from = std::min(std::max(points[point], 0.0f), 1.0f);
+        float to = std::min(std::max(points[point + 1], 0.0f), 1.0f);
+        values[i] = (float) (from + (position - point) * (to - from));
+    }
+    setEndSlope();
+}
+
+void TrajectoryTable::setEndSlope()
+{
+    end_slope = std::min(std::max((values[size] - values[size - 1]) * (float) size, -1.0f), 1.0f);
+}
@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    TrajectoryTable.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Shapes for the trajectory engine. The drawn shape is whatever curve the
+// editor last sent; the others are built in.
+enum TrajectoryShape { shape_sawtooth = 0, shape_triangle, shape_stepped, shape_random_walk, shape_drawn };
+#define NUM_TRAJECTORY_SHAPES 5
+#define NUM_BUILT_IN_SHAPES shape_drawn
+
+// A drawn curve is sent as up to this many evenly spaced points, and saved
+// with the plugin state the same way.
+const int max_drawn_points = 64;
+
+// How far through the delay sweep the read head is, from 0 to 1, over one
+// grain. The engine scales it by the grain's depth, so the slope of the table
+// is the pitch and its value is the delay.
+struct TrajectoryTable {
+    static const int size = 1024;
+
+    // size + 1 points, so the lookup can interpolate up to the grain's end.
+    float values[size + 1];
+    // Past the end of the grain, the crossfade into the next one keeps
+    // following this slope. It is held to at most the sawtooth's, so the
+    // delay can't run past the history while the old grain fades out.
+    float end_slope;
+
+    // phase is 0 at the start of the grain and 1 at the end.
+    inline double getValue(double phase) const {
+        if (phase >= 1.0) {
+            return values[size] + (phase - 1.0) * end_slope;
+        }
+        double index = phase * size;
+        int i = (int) index;
+        return values[i] + (index - i) * (values[i + 1] - values[i]);
+    }
+
+    void setSawtooth();
+    void setTriangle();
+    // Four flat steps joined by short cosine ramps.
+    void setStepped();
+    // A smoothed random walk, stretched to fill 0 to 1. It is the same walk
+    // every time, so a saved session sounds the way it did.
+    void setRandomWalk();
+    // Resamples numPoints evenly spaced points, clamped to 0 to 1, with
+    // straight lines between them.
+    void setFromPoints(const float* points, int numPoints);
+
+private:
+    void setEndSlope();
+};
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+
+// Hands whole values from one writer thread to one reader thread without
+// either of them waiting. There are three slots: the writer fills its back
+// slot and swaps it into the middle, and the reader swaps the middle out for
+// its front slot when there is something new. Each side only ever touches the
+// slot it holds, so neither can see a half written value, and a value that is
+// published before the reader gets to it is simply replaced by the next one.
+//
+//     writer: fill(getBack()); publish();
+//     reader: if (acquire()) use(getFront());
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer(): back(0), middle(1), front(2) {}
+
+    // Writer side.
+    T& getBack() { return slots[back]; }
+    void publish() {
+        back = middle.exchange(back | fresh_bit) & index_mask;
+    }
+
+    // Reader side. True if a newer value was published since the last call,
+    // which getFront then returns until the next one.
+    bool acquire() {
+        if ((middle.load() & fresh_bit) == 0) {
+            return false;
+        }
+        front = middle.exchange(front) & index_mask;
+        return true;
+    }
+    const T& getFront() const { return slots[front]; }
+
+private:
+    static const int fresh_bit = 4;
+    static const int index_mask = 3;
+
+    T slots[3];
+    int back;
+    std::atomic<int> middle; // slot index, with fresh_bit set until the reader takes it
+    int front;
+};